@@ -26,11 +26,15 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include <algorithm>
 #include <bit>
 #include <memory>
+#include <span>
 #include <stdexcept>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
+#include <string_view>
+#include <vector>
 #ifndef macintosh
 #include <fcntl.h>
 #endif
@@ -52,6 +56,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 
 #include "compiler-range_for.h"
 #include "partial_range.h"
+#include "d_enumerate.h"
 #include "d_range.h"
 #include <array>
 #include <memory>
@@ -92,15 +97,19 @@ constexpr std::integral_constant<uint8_t, 255> kerndata_terminator{};
 static int gr_internal_string_clipped(grs_canvas &, const grs_font &cv_font, int x, int y, const char *s);
 static int gr_internal_string_clipped_m(grs_canvas &, const grs_font &cv_font, int x, int y, const char *s);
 
-static const uint8_t *find_kern_entry(const grs_font &font, const uint8_t first, const uint8_t second)
+static std::unique_ptr<grs_font_kern_table> build_kern_table(const uint8_t *p)
 {
-	auto p{font.ft_kerndata};
-
-	while (*p != kerndata_terminator)
-		if (p[0]==first && p[1]==second)
-			return p;
-		else p+=3;
-	return NULL;
+	auto result{std::make_unique<grs_font_kern_table>()};
+	for (; *p != kerndata_terminator; p += 3)
+	{
+		auto &present{result->present[p[0]]};
+		/* If a pair is listed more than once, the first entry wins. */
+		if (present[p[1]])
+			continue;
+		present.set(p[1]);
+		result->spacing[p[0]][p[1]] = p[2];
+	}
+	return result;
 }
 
 //takes the character AFTER being offset into font
@@ -159,16 +168,16 @@ static get_char_width_result<T> get_char_width(const grs_font &cv_font, const ui
 			const unsigned letter2 = c2 - cv_font.ft_minchar;
 
 			if (INFONT(letter2)) {
-				const auto p{find_kern_entry(cv_font, letter, letter2)};
-				if (p)
-					return {width, static_cast<T>(fontscale_x(p[2]))};
+				auto &kt{*cv_font.ft_kerntable};
+				if (kt.present[letter][letter2])
+					return {width, static_cast<T>(fontscale_x(kt.spacing[letter][letter2]))};
 			}
 		}
 	}
 	return {width, width};
 }
 
-static int get_centered_x(const grs_canvas &canvas, const grs_font &cv_font, const char *s)
+static float get_centered_width(const grs_font &cv_font, const char *s)
 {
 	float w{0.f};
 	for (; const char c{*s}; ++s)
@@ -183,10 +192,19 @@ static int get_centered_x(const grs_canvas &canvas, const grs_font &cv_font, con
 		}
 		w += get_char_width<float>(cv_font, c, s[1]).spacing;
 	}
+	return w;
+}
 
+static int get_centered_x(const grs_canvas &canvas, const float w)
+{
 	return (canvas.cv_bitmap.bm_w - w) / 2;
 }
 
+static int get_centered_x(const grs_canvas &canvas, const grs_font &cv_font, const char *s)
+{
+	return get_centered_x(canvas, get_centered_width(cv_font, s));
+}
+
 //hack to allow color codes to be embedded in strings -MPM
 //note we subtract one from color, since 255 is "transparent" so it'll never be used, and 0 would otherwise end the string.
 //function must already have orig_color var set (or they could be passed as args...)
@@ -217,6 +235,216 @@ struct per_character_row_state
 		text_ptr++; \
 	}
 
+/* The measured size of a string and, for OpenGL, the position of each
+ * glyph relative to the start of its row.  HUD and menu strings are
+ * mostly redrawn unchanged every frame, so the layout is cached by
+ * (font, text) instead of measuring each glyph again.
+ */
+struct string_layout
+{
+	enum class op_kind : uint8_t
+	{
+		glyph,
+		set_color,
+		reset_color,
+		underline,
+	};
+	struct op
+	{
+		op_kind kind;
+		uint8_t value;	//letter for glyph, color for set_color
+		int x;
+		int dw;
+	};
+	struct row
+	{
+		float centered_width;
+		std::size_t begin_op, end_op;
+	};
+	font_x_scale_proportion scale_x;
+	font_y_scale_proportion scale_y;
+	float fspacy1;
+	gr_string_size size;
+#if DXX_USE_OGL
+	std::span<const row> rows;
+	std::span<const op> ops;
+#endif
+};
+
+/* Every character of the text adds at most one op, so a cached entry
+ * needs no more ops than characters.  Longer strings, and strings with
+ * more rows, are laid out each time they are drawn.
+ */
+constexpr std::size_t max_cached_string_layout_text{127};
+#if DXX_USE_OGL
+constexpr std::size_t max_cached_string_layout_rows{8};
+#endif
+
+/* Storage is inline, so that replacing an entry never allocates.
+ * `last_used` is zero for an entry which has never been filled.
+ */
+struct string_layout_cache_entry
+{
+	uint64_t last_used;
+	std::size_t hash;
+	unsigned font_id;
+	uint8_t text_length;
+	std::array<char, max_cached_string_layout_text> text;
+	string_layout layout;
+#if DXX_USE_OGL
+	std::array<string_layout::row, max_cached_string_layout_rows> rows;
+	std::array<string_layout::op, max_cached_string_layout_text> ops;
+#endif
+	std::string_view get_text() const
+	{
+		return {text.data(), text_length};
+	}
+};
+
+/* Bound the cache, so that strings which change every frame (timers,
+ * scores) evict only the entry used longest ago, rather than growing the
+ * cache or discarding the strings that are still drawn every frame.
+ */
+static std::array<string_layout_cache_entry, 128> String_layout_cache;
+static uint64_t String_layout_clock;
+static string_layout String_layout_uncached;
+static unsigned Next_font_layout_id;
+
+#if DXX_USE_OGL
+/* Reused for every layout that is built, so that they only allocate
+ * when a string is longer than any seen before.
+ */
+static std::vector<string_layout::row> String_layout_build_rows;
+static std::vector<string_layout::op> String_layout_build_ops;
+
+static void build_string_layout_rows(const grs_font &cv_font, const char *const s, std::vector<string_layout::row> &rows, std::vector<string_layout::op> &ops)
+{
+	const font_character_extent INFONT{cv_font};
+	const auto &&fontscale_x{FONTSCALE_X()};
+	rows.clear();
+	ops.clear();
+	for (auto next_row{s}; next_row;)
+	{
+		auto text_ptr{std::exchange(next_row, nullptr)};
+		const auto begin_op{ops.size()};
+		const auto centered_width{get_centered_width(cv_font, text_ptr)};
+		int line_x{0};
+		for (; const auto c0{*text_ptr};)
+		{
+			if (c0 == '\n')
+			{
+				next_row = &text_ptr[1];
+				break;
+			}
+
+			const auto letter{c0 - cv_font.ft_minchar};
+			const auto spacing{get_char_width<int>(cv_font, c0, text_ptr[1]).spacing};
+
+			if (!INFONT(letter) || c0 <= 0x06) //not in font, draw as space
+			{
+				/* Record the same effects that CHECK_EMBEDDED_COLORS
+				 * would have on the canvas.
+				 */
+				if (c0 >= 0x01 && c0 <= 0x02)
+				{
+					text_ptr++;
+					if (*text_ptr)
+					{
+						if (gr_message_color_level >= c0)
+							ops.push_back({string_layout::op_kind::set_color, static_cast<uint8_t>(*text_ptr), line_x, 0});
+						text_ptr++;
+					}
+				}
+				else if (c0 == 0x03)
+				{
+					ops.push_back({string_layout::op_kind::underline, 0, line_x, 0});
+					text_ptr++;
+				}
+				else if (c0 >= 0x04 && c0 <= 0x06)
+				{
+					if (gr_message_color_level >= c0 - 3)
+						ops.push_back({string_layout::op_kind::reset_color, 0, line_x, 0});
+					text_ptr++;
+				}
+				else
+				{
+					line_x += spacing;
+					text_ptr++;
+				}
+				continue;
+			}
+			const auto ft_w{(cv_font.ft_flags & FT_PROPORTIONAL)
+				? cv_font.ft_widths[letter]
+				: cv_font.ft_w};
+			ops.push_back({string_layout::op_kind::glyph, static_cast<uint8_t>(letter), line_x, static_cast<int>(fontscale_x(ft_w))});
+			line_x += spacing;
+			text_ptr++;
+		}
+		rows.push_back({centered_width, begin_op, ops.size()});
+	}
+}
+#endif
+
+static const string_layout &get_string_layout(const grs_font &cv_font, const char *const s)
+{
+	const auto fspacy1{FSPACY(1).operator float()};
+	const std::string_view text{s};
+	const auto font_id{cv_font.ft_layout_id};
+	const auto hash{std::hash<std::string_view>{}(text) ^ font_id};
+	const auto now{++ String_layout_clock};
+	/* Find the entry, and remember the one used longest ago in case
+	 * there is none.
+	 */
+	auto victim{&String_layout_cache.front()};
+	for (auto &e : String_layout_cache)
+	{
+		if (e.last_used && e.hash == hash && e.font_id == font_id && e.get_text() == text)
+		{
+			e.last_used = now;
+			auto &layout{e.layout};
+			if (layout.scale_x == FNTScaleX && layout.scale_y == FNTScaleY && layout.fspacy1 == fspacy1)
+				return layout;
+			victim = &e;
+			break;
+		}
+		if (e.last_used < victim->last_used)
+			victim = &e;
+	}
+	const string_layout layout{
+		.scale_x = FNTScaleX,
+		.scale_y = FNTScaleY,
+		.fspacy1 = fspacy1,
+		.size = gr_get_string_size(cv_font, s, UINT_MAX),
+	};
+#if DXX_USE_OGL
+	auto &rows{String_layout_build_rows};
+	auto &ops{String_layout_build_ops};
+	build_string_layout_rows(cv_font, s, rows, ops);
+	if (text.size() > max_cached_string_layout_text || rows.size() > max_cached_string_layout_rows)
+	{
+		String_layout_uncached = layout;
+		String_layout_uncached.rows = rows;
+		String_layout_uncached.ops = ops;
+		return String_layout_uncached;
+	}
+#else
+	if (text.size() > max_cached_string_layout_text)
+		return String_layout_uncached = layout;
+#endif
+	auto &e{*victim};
+	e.last_used = now;
+	e.hash = hash;
+	e.font_id = font_id;
+	e.text_length = text.size();
+	std::ranges::copy(text, e.text.begin());
+	e.layout = layout;
+#if DXX_USE_OGL
+	e.layout.rows = {e.rows.begin(), std::ranges::copy(rows, e.rows.begin()).out};
+	e.layout.ops = {e.ops.begin(), std::ranges::copy(ops, e.ops.begin()).out};
+#endif
+	return e.layout;
+}
+
 template <bool masked_draws_background>
 static int gr_internal_string0_template(grs_canvas &canvas, const grs_font &cv_font, const int x, int y, const char *const s)
 {
@@ -630,52 +858,39 @@ static void ogl_internal_string(grs_canvas &canvas, const grs_font &cv_font, con
 	if (grd_curscreen->sc_canvas.cv_bitmap.get_type() != bm_mode::ogl)
 		Error("carp.\n");
 	const auto &&fspacy1{FSPACY(1)};
-	const font_character_extent INFONT{cv_font};
-	const auto &&fontscale_x{FONTSCALE_X()};
 	const auto &&FONTSCALE_Y_ft_h{FONTSCALE_Y(cv_font.ft_h)};
+	const auto &layout{get_string_layout(cv_font, s)};
 	ogl_colors colors;
-	for (auto next_row{s}; next_row;)
+	ogl_bitmap_batch batch;
+	for (auto &&[row_index, row] : enumerate(layout.rows))
 	{
-		auto text_ptr{std::exchange(next_row, nullptr)};
-		auto line_x{entry_x == 0x8000
-			? get_centered_x(canvas, cv_font, text_ptr)
+		if (row_index)
+			yy += FONTSCALE_Y_ft_h + fspacy1;
+		const auto line_x{entry_x == 0x8000
+			? get_centered_x(canvas, row.centered_width)
 			: entry_x};
-
-		for (; const auto c0{*text_ptr};)
+		for (auto &op : layout.ops.subspan(row.begin_op, row.end_op - row.begin_op))
 		{
-			if (c0 == '\n')
+			const auto x{line_x + op.x};
+			switch (op.kind)
 			{
-				next_row = &text_ptr[1];
-				yy += FONTSCALE_Y_ft_h + fspacy1;
-				break;
-			}
-
-			const auto letter{c0 - cv_font.ft_minchar};
-			const auto spacing{get_char_width<int>(cv_font, c0, text_ptr[1]).spacing};
-
-			per_character_row_state state;
-			if (!INFONT(letter) || c0 <= 0x06) //not in font, draw as space
-			{
-				CHECK_EMBEDDED_COLORS() else{
-					line_x += spacing;
-					text_ptr++;
-				}
-				if (state.draw_full_width_as_fg_color)
-				{
-					const auto color{canvas.cv_font_fg_color};
-					gr_rect(canvas, line_x, yy + cv_font.ft_baseline + 2, line_x + cv_font.ft_w, yy + cv_font.ft_baseline + 3, color);
-				}
-
-				continue;
+				case string_layout::op_kind::glyph:
+					batch.add(canvas, x, yy, op.dw, FONTSCALE_Y_ft_h, cv_font.ft_bitmaps[op.value], (cv_font.ft_flags & FT_COLOR) ? colors.white : (canvas.cv_bitmap.get_type() == bm_mode::ogl) ? colors.init(canvas.cv_font_fg_color) : throw std::runtime_error("non-color string to non-ogl dest"));
+					break;
+				case string_layout::op_kind::set_color:
+					canvas.cv_font_fg_color = op.value;
+					break;
+				case string_layout::op_kind::reset_color:
+					canvas.cv_font_fg_color = orig_color;
+					break;
+				case string_layout::op_kind::underline:
+					{
+						batch.flush();
+						const auto color{canvas.cv_font_fg_color};
+						gr_rect(canvas, x, yy + cv_font.ft_baseline + 2, x + cv_font.ft_w, yy + cv_font.ft_baseline + 3, color);
+					}
+					break;
 			}
-			const auto ft_w{(cv_font.ft_flags & FT_PROPORTIONAL)
-				? cv_font.ft_widths[letter]
-				: cv_font.ft_w};
-
-			ogl_ubitmapm_cs(canvas, line_x, yy, fontscale_x(ft_w), FONTSCALE_Y_ft_h, cv_font.ft_bitmaps[letter], (cv_font.ft_flags & FT_COLOR) ? colors.white : (canvas.cv_bitmap.get_type() == bm_mode::ogl) ? colors.init(canvas.cv_font_fg_color) : throw std::runtime_error("non-color string to non-ogl dest"));
-
-			line_x += spacing;
-			text_ptr++;
 		}
 	}
 }
@@ -806,7 +1021,9 @@ unsigned gr_get_string_height(const grs_font &cv_font, const unsigned lines)
 
 gr_string_size gr_get_string_size(const grs_font &cv_font, const char *s)
 {
-	return gr_get_string_size(cv_font, s, UINT_MAX);
+	if (!s)
+		return gr_get_string_size(cv_font, s, UINT_MAX);
+	return get_string_layout(cv_font, s).size;
 }
 
 gr_string_size gr_get_string_size(const grs_font &cv_font, const char *s, const unsigned max_chars_per_line)
@@ -1015,6 +1232,7 @@ static std::unique_ptr<grs_font> gr_internal_init_font(const std::span<const cha
 				break;
 		}
 		font->ft_kerndata = begin_kerndata;
+		font->ft_kerntable = build_kern_table(begin_kerndata);
 	}
 	else
 		font->ft_kerndata = nullptr;
@@ -1046,6 +1264,7 @@ static std::unique_ptr<grs_font> gr_internal_init_font(const std::span<const cha
 
 	auto &ft_filename{font->ft_filename};
 	font->ft_allocdata = std::move(ft_allocdata);
+	font->ft_layout_id = ++ Next_font_layout_id;
 	std::memcpy(ft_filename.data(), fontname.data(), std::min(fontname.size(), std::size(ft_filename) - 1));
 	return font;
 }
@@ -27,6 +27,17 @@ PFNGLFENCESYNCPROC glFenceSyncFunc = NULL;
 PFNGLDELETESYNCPROC glDeleteSyncFunc = NULL;
 PFNGLCLIENTWAITSYNCPROC glClientWaitSyncFunc = NULL;
 
+/* GL_ARB_vertex_buffer_object */
+bool ogl_have_ARB_vertex_buffer_object = false;
+PFNGLBINDBUFFERPROC glBindBufferFunc = NULL;
+PFNGLDELETEBUFFERSPROC glDeleteBuffersFunc = NULL;
+PFNGLGENBUFFERSPROC glGenBuffersFunc = NULL;
+PFNGLBUFFERDATAPROC glBufferDataFunc = NULL;
+PFNGLBUFFERSUBDATAPROC glBufferSubDataFunc = NULL;
+
+/* GL_EXT_multi_draw_arrays */
+PFNGLMULTIDRAWELEMENTSPROC glMultiDrawElementsFunc = NULL;
+
 /* GL_EXT_texture_filter_anisotropic */
 GLfloat ogl_maxanisotropy = 0.0f;
 
@@ -138,6 +149,28 @@ void ogl_extensions_init()
 		? (ogl_have_ARB_sync = true, std::span<const char>{"DXX-Rebirth: OpenGL: GL_ARB_sync available"})
 		: std::span<const char>{"DXX-Rebirth: OpenGL: GL_ARB_sync not available"};
 	con_puts(CON_VERBOSE, s);
+
+	/* GL_ARB_vertex_buffer_object */
+	if (const auto vbo = is_supported(extension_str, version, "GL_ARB_vertex_buffer_object", 1, 5, -1, -1)) {
+		/* Before OpenGL 1.5, the entry points carry the ARB suffix. */
+		const bool arb = (vbo == SUPPORT_EXT);
+		glBindBufferFunc = reinterpret_cast<PFNGLBINDBUFFERPROC>(SDL_GL_GetProcAddress(arb ? "glBindBufferARB" : "glBindBuffer"));
+		glDeleteBuffersFunc = reinterpret_cast<PFNGLDELETEBUFFERSPROC>(SDL_GL_GetProcAddress(arb ? "glDeleteBuffersARB" : "glDeleteBuffers"));
+		glGenBuffersFunc = reinterpret_cast<PFNGLGENBUFFERSPROC>(SDL_GL_GetProcAddress(arb ? "glGenBuffersARB" : "glGenBuffers"));
+		glBufferDataFunc = reinterpret_cast<PFNGLBUFFERDATAPROC>(SDL_GL_GetProcAddress(arb ? "glBufferDataARB" : "glBufferData"));
+		glBufferSubDataFunc = reinterpret_cast<PFNGLBUFFERSUBDATAPROC>(SDL_GL_GetProcAddress(arb ? "glBufferSubDataARB" : "glBufferSubData"));
+	}
+	const auto v = (glBindBufferFunc && glDeleteBuffersFunc && glGenBuffersFunc && glBufferDataFunc && glBufferSubDataFunc)
+		? (ogl_have_ARB_vertex_buffer_object = true, std::span<const char>{"DXX-Rebirth: OpenGL: GL_ARB_vertex_buffer_object available"})
+		: std::span<const char>{"DXX-Rebirth: OpenGL: GL_ARB_vertex_buffer_object not available"};
+	con_puts(CON_VERBOSE, v);
+
+	/* GL_EXT_multi_draw_arrays */
+	if (const auto mda = is_supported(extension_str, version, "GL_EXT_multi_draw_arrays", 1, 4, -1, -1))
+		glMultiDrawElementsFunc = reinterpret_cast<PFNGLMULTIDRAWELEMENTSPROC>(SDL_GL_GetProcAddress(mda == SUPPORT_EXT ? "glMultiDrawElementsEXT" : "glMultiDrawElements"));
+	con_puts(CON_VERBOSE, glMultiDrawElementsFunc
+		? std::span<const char>{"DXX-Rebirth: OpenGL: GL_EXT_multi_draw_arrays available"}
+		: std::span<const char>{"DXX-Rebirth: OpenGL: GL_EXT_multi_draw_arrays not available"});
 }
 
 }
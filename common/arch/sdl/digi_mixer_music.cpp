@@ -12,7 +12,13 @@
  *  -- MD2211 (2006-04-24)
  */
 
+#include <algorithm>
+#include <deque>
+#include <mutex>
 #include <span>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <SDL.h>
 #include <SDL_mixer.h>
 #include <string.h>
@@ -159,6 +165,110 @@ uintptr_t current_music_t::reset(RWops_ptr rw)
 static current_music_t current_music;
 static std::vector<uint8_t> current_music_hndlbuf;
 
+/* Converting an HMP to MIDI reads and rewrites every track, which can be
+ * noticeable when a level starts.  Keep the most recently used
+ * conversions, and allow the next song to be converted on a background
+ * thread before it is needed.
+ */
+class hmp_midi_cache
+{
+	struct entry
+	{
+		std::string filename;
+		std::vector<uint8_t> midi;
+	};
+	static constexpr std::size_t maximum_entries{4};
+	std::mutex mutex;
+	/* Least recently used first */
+	std::deque<entry> entries;
+	std::thread prefetch_thread;
+	/* The song that prefetch_thread converts.  Only the main thread uses
+	 * this.
+	 */
+	std::string prefetch_filename;
+	std::deque<entry>::iterator find(const char *filename);
+	void join_prefetch()
+	{
+		if (prefetch_thread.joinable())
+			prefetch_thread.join();
+	}
+public:
+	~hmp_midi_cache()
+	{
+		join_prefetch();
+	}
+	/* If `filename` is being prefetched, wait for it.  Waiting is no
+	 * slower than converting it again.
+	 */
+	void wait_prefetch(const char *const filename)
+	{
+		if (prefetch_filename == filename)
+			join_prefetch();
+	}
+	void clear();
+	bool copy_out(const char *filename, std::vector<uint8_t> &midi);
+	void insert(const char *filename, std::vector<uint8_t> midi);
+	void prefetch(const char *filename);
+};
+
+std::deque<hmp_midi_cache::entry>::iterator hmp_midi_cache::find(const char *const filename)
+{
+	return std::ranges::find(entries, std::string_view{filename}, &entry::filename);
+}
+
+bool hmp_midi_cache::copy_out(const char *const filename, std::vector<uint8_t> &midi)
+{
+	const std::lock_guard lock{mutex};
+	const auto i{find(filename)};
+	if (i == entries.end())
+		return false;
+	midi = i->midi;
+	/* Move the entry to the back, so that it is evicted last. */
+	auto e{std::move(*i)};
+	entries.erase(i);
+	entries.emplace_back(std::move(e));
+	return true;
+}
+
+void hmp_midi_cache::insert(const char *const filename, std::vector<uint8_t> midi)
+{
+	const std::lock_guard lock{mutex};
+	if (const auto i{find(filename)}; i != entries.end())
+		entries.erase(i);
+	entries.emplace_back(entry{filename, std::move(midi)});
+	if (entries.size() > maximum_entries)
+		entries.pop_front();
+}
+
+void hmp_midi_cache::clear()
+{
+	join_prefetch();
+	prefetch_filename.clear();
+	const std::lock_guard lock{mutex};
+	entries.clear();
+}
+
+void hmp_midi_cache::prefetch(const char *const filename)
+{
+	join_prefetch();
+	{
+		const std::lock_guard lock{mutex};
+		if (find(filename) != entries.end())
+			return;
+	}
+	prefetch_filename = filename;
+	prefetch_thread = std::thread([this](std::string filename) {
+		/* Errors are not reported here.  If the file cannot be converted,
+		 * then it is not cached, and mix_play_file will try again and
+		 * report the error.
+		 */
+		if (auto &&[v, hoe, pec] = hmp2mid(filename.c_str()); hoe == hmp_open_error::None)
+			insert(filename.c_str(), std::move(v));
+	}, std::string{filename});
+}
+
+static hmp_midi_cache hmp_cache;
+
 static void mix_set_music_type_sdlmixer(int loop, void (*const hook_finished_track)())
 {
 	Mix_PlayMusic(current_music.get(), (loop ? -1 : 1));
@@ -235,16 +345,21 @@ int mix_play_file(const char *filename, int loop, void (*const entry_hook_finish
 	// It's a .hmp!
 	if (const auto fptr = strrchr(filename, '.'); fptr && !d_stricmp(fptr, ".hmp"))
 	{
-		if (auto &&[v, hoe] = hmp2mid(filename); hoe == hmp_open_error::None)
+		hmp_cache.wait_prefetch(filename);
+		if (!hmp_cache.copy_out(filename, current_music_hndlbuf))
 		{
+			auto &&[v, hoe, pec] = hmp2mid(filename);
+			if (hoe != hmp_open_error::None)
+			{
+				hmp_report_open_error(filename, hoe, pec);
+				return 0;
+			}
+			hmp_cache.insert(filename, v);
 			current_music_hndlbuf = std::move(v);
-			current_music_type = load_mus_data(filename, current_music_hndlbuf, loop, hook_finished_track);
-			if (current_music_type != CurrentMusicType::None)
-				return 1;
 		}
-		else
-			/* hmp2mid printed an error message, so there is no need for another one here */
-			return 0;
+		current_music_type = load_mus_data(filename, current_music_hndlbuf, loop, hook_finished_track);
+		if (current_music_type != CurrentMusicType::None)
+			return 1;
 	}
 
 	// try loading music via given filename
@@ -291,6 +406,27 @@ int mix_play_file(const char *filename, int loop, void (*const entry_hook_finish
 	return 0;
 }
 
+/*
+ *  Convert an HMP file to MIDI in the background, so that a later
+ *  mix_play_file for the same file does not need to convert it.  Other
+ *  formats are loaded directly by SDL_mixer or ADLMIDI, so they are not
+ *  prefetched.
+ */
+void mix_prefetch_file(const char *const filename)
+{
+	if (const auto fptr = strrchr(filename, '.'); fptr && !d_stricmp(fptr, ".hmp"))
+		hmp_cache.prefetch(filename);
+}
+
+/* Cached songs are found by name, so they must be dropped when the set of
+ * archives that a name could resolve to changes.  This also closes any
+ * file that the prefetch thread holds open in an archive.
+ */
+void mix_clear_music_cache()
+{
+	hmp_cache.clear();
+}
+
 // What to do when stopping song playback
 void mix_free_music()
 {
@@ -57,6 +57,7 @@ enum SyncGLMethod : uint8_t {
 //   Edi - Editor Options
 //   Dbg - Debugging/Undocumented Options
 #include <string>
+#include <vector>
 #include "dxxsconf.h"
 #include "dsx-ns.h"
 #include "pack.h"
@@ -100,6 +101,8 @@ struct CArg : prohibit_void_ptr<CArg>
 	bool OglFixedFont;
 	SyncGLMethod OglSyncMethod;
 	bool OglDarkEdges;
+	bool OglLevelVBO;
+	bool OglHudAtlas;
 	bool DbgUseOldTextureMerge;
 	bool DbgGlIntensity4Ok;
 	bool DbgGlReadPixelsOk;
@@ -126,6 +129,10 @@ struct CArg : prohibit_void_ptr<CArg>
 #endif
 	bool SysNoNiceFPS;
 	int SysMaxFPS;
+	unsigned SysFixedTickRate;
+	unsigned SysDemoCaptureRate;
+	unsigned SysObjectHeadroom;
+	unsigned SysWorkerThreads;
 	int SysRenderZoomAdjustment;
 	uint16_t MplUdpHostPort;
 	uint16_t MplUdpMyPort;
@@ -137,6 +144,7 @@ struct CArg : prohibit_void_ptr<CArg>
 	std::string SysHogDir;
 	std::string SysPilot;
 	std::string SysRecordDemoNameTemplate;
+	std::vector<std::string> SysAnalyzeDemos;
 	std::string MplUdpHostAddr;
 	std::string DbgAltTex;
 #if !DXX_USE_OGL
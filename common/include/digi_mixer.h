@@ -71,5 +71,6 @@ int digi_mixer_init();
 }
 namespace dsx {
 sound_channel digi_mixer_start_sound(sound_effect, fix, sound_pan, int, int, int, sound_object *);
+void digi_mixer_preload_sounds();
 }
 #endif
@@ -0,0 +1,137 @@
+/*
+ * This file is part of the DXX-Rebirth project <https://www.dxx-rebirth.com/>.
+ * It is copyright by its individual contributors, as recorded in the
+ * project's Git history.  See COPYING.txt at the top level for license
+ * terms and a link to the Git history.
+ */
+
+/*
+ * Upsampling low-pass filter used by the SoundBlaster16 emulation of the
+ * SDL_mixer backend.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "d_range.h"
+
+namespace dcx {
+
+namespace soundblaster16_filter {
+
+/*
+ * Blackman windowed-sinc filter coefficients at 1/4 bandwidth of upsampled
+ * frequency. Chosen for linear phase and approximates ~10th order IIR
+ *
+ * MATLAB/Octave code:
+
+	N = 51;   % Num coeffs (odd)
+	B = 0.25;  % 1/4 band
+	half = (N-1)/2;
+	n = (-half:half); % the sample index
+	% Windowed sinc
+	h_ideal = 2 * B .* sinc(B*n);
+	h_win = blackman(N);
+	b = h_win .* h_ideal.';
+	% Convert to fix point to ultimately apply to signed 16-bit data
+	b_s16 = int32(round(b * (2^16 -1)));  % coeffs!
+
+ */
+constexpr std::size_t FILTER_LEN = 51;
+using filter_coefficients = std::array<int32_t, FILTER_LEN>;
+
+constexpr filter_coefficients coeffs_quarterband{{
+		0, 0, -7, -25, -35, 0, 94, 200, 205, 0, -395, -751, -702, 0, 1178, 2127,
+		1907, 0, -3050, -5490, -5011, 0, 9275, 20326, 29311, 32767, 29311,
+		20326, 9275, 0, -5011, -5490, -3050, 0, 1907, 2127, 1178, 0, -702,
+		-751, -395, 0, 205, 200, 94, 0, -35, -25, -7, 0, 0
+}};
+
+// Coefficient set for half-band (e.g. 22050 -> 44100)
+constexpr filter_coefficients coeffs_halfband{{
+		0, 0, -11, 0, 49, 0, -133, 0, 290, 0, -558, 0, 992, 0, -1666, 0, 2697, 0,
+		-4313, 0, 7086, 0, -13117, 0, 41452, 65535, 41452, 0, -13117, 0, 7086, 0,
+		-4313, 0, 2697, 0, -1666, 0, 992, 0, -558, 0, 290, 0, -133, 0, 49, 0, -11,
+		0, 0
+}};
+
+constexpr bool is_symmetric(const filter_coefficients &coeffs)
+{
+	for (std::size_t i = 0; i < FILTER_LEN / 2; ++i)
+		if (coeffs[i] != coeffs[FILTER_LEN - 1 - i])
+			return false;
+	return true;
+}
+
+/* upsample_filter pairs taps that are reflections of each other, which is
+ * only correct for a symmetric kernel.
+ */
+static_assert(is_symmetric(coeffs_quarterband));
+static_assert(is_symmetric(coeffs_halfband));
+
+/* Upsample unsigned 8-bit `input` by `factor`, then apply `coeffs` as a
+ * low-pass FIR filter, writing `input.size() * factor` signed 16-bit
+ * samples to `output`.
+ *
+ * The result is identical to inserting `factor - 1` zero samples after
+ * every input sample and convolving that signal with `coeffs`.  Instead of
+ * multiplying the inserted zeros, output sample `q * factor + r` only uses
+ * the taps `coeffs[j * factor + r]`, so each of the `factor` phases is a
+ * short filter over the original samples.  Zero taps are skipped, and taps
+ * that mirror each other within a phase share one multiply.  Each phase is
+ * accumulated across all input positions at once, so that the compiler
+ * can vectorize the multiply-accumulate.
+ */
+inline void upsample_filter(const std::span<const uint8_t> input, const std::size_t factor, const filter_coefficients &coeffs, const std::span<int16_t> output)
+{
+	const std::size_t count = input.size();
+	/* The longest phase reaches this many input samples into the past.
+	 * Samples before the start of the input are zero.
+	 */
+	const std::size_t history = (FILTER_LEN - 1) / factor;
+	std::vector<int32_t> signal(history + count);
+	for (const auto i : xrange(count))
+	{
+		constexpr int32_t convert_u8_to_s8{INT8_MIN};
+		signal[history + i] = int32_t{input[i]} + convert_u8_to_s8;
+	}
+	std::vector<int32_t> accumulator(count);
+	const auto acc = accumulator.data();
+	for (const auto r : xrange(factor))
+	{
+		std::fill(accumulator.begin(), accumulator.end(), 0);
+		for (std::size_t j = 0, t = r; t < FILTER_LEN; ++j, t += factor)
+		{
+			const auto c = coeffs[t];
+			if (!c)
+				continue;
+			/* Output `q` reads sample `q - j` for this tap. */
+			const auto a = &signal[history - j];
+			const auto mirror = FILTER_LEN - 1 - t;
+			if (mirror % factor != r || mirror == t)
+			{
+				for (const auto q : xrange(count))
+					acc[q] += c * a[q];
+				continue;
+			}
+			if (mirror < t)
+				/* Already added along with its mirror. */
+				continue;
+			const auto b = &signal[history - (mirror - r) / factor];
+			for (const auto q : xrange(count))
+				acc[q] += c * (a[q] + b[q]);
+		}
+		for (const auto q : xrange(count))
+			// Save and fit back into int16
+			output[q * factor + r] = static_cast<int16_t>(acc[q] >> 8);  // Arithmetic shift
+	}
+}
+
+}
+
+}
@@ -17,6 +17,8 @@ namespace dcx {
 
 int mix_play_music(const char *, int);
 int mix_play_file(const char *, int, void (*)());
+void mix_prefetch_file(const char *);
+void mix_clear_music_cache();
 void mix_set_music_volume(int);
 void mix_stop_music();
 void mix_pause_music();
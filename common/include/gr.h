@@ -34,6 +34,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "dsx-ns.h"
 #include "pack.h"
 #include <array>
+#include <bitset>
 
 #if DXX_USE_SDLIMAGE || !DXX_USE_OGL
 #include <memory>
@@ -314,6 +315,14 @@ class grs_subbitmap : public grs_bitmap
 {
 };
 
+// Kerned spacing for each pair of characters in a font, indexed by the
+// characters after offsetting them into the font.  Built from ft_kerndata.
+struct grs_font_kern_table
+{
+	std::array<std::array<uint8_t, 256>, 256> spacing;
+	std::array<std::bitset<256>, 256> present;
+};
+
 //font structure
 struct grs_font : public prohibit_void_ptr<grs_font>
 {
@@ -329,6 +338,8 @@ struct grs_font : public prohibit_void_ptr<grs_font>
 	const uint16_t *ft_widths = nullptr;     // Array of widths (required for prop font)
 	const uint8_t *ft_kerndata = nullptr;    // Array of kerning triplet data
 	std::unique_ptr<uint8_t[]> ft_allocdata;
+	std::unique_ptr<grs_font_kern_table> ft_kerntable;	// Lookup table for ft_kerndata, if FT_KERNED
+	unsigned ft_layout_id{};	// Distinguishes each load of a font in the string layout cache
 #if DXX_USE_OGL
 	// These fields do not participate in disk i/o!
 	std::unique_ptr<grs_bitmap[]> ft_bitmaps;
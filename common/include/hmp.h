@@ -122,10 +122,14 @@ enum class hmp_open_error : uint8_t
  * hmp_open_error::physfs_* code.  Otherwise, it is formally undefined.
  * Informally, it is 0. */
 using hmp_open_result = std::tuple<std::unique_ptr<hmp_file>, hmp_open_error, PHYSFS_ErrorCode>;
-using hmpmid_result = std::tuple<std::vector<uint8_t>, hmp_open_error>;
+using hmpmid_result = std::tuple<std::vector<uint8_t>, hmp_open_error, PHYSFS_ErrorCode>;
 
 hmp_open_result hmp_open(const char *filename);
+/* hmp2mid does not report errors, so that it can be used off the main
+ * thread.  Use hmp_report_open_error to report a failure.
+ */
 hmpmid_result hmp2mid(const char *hmp_name);
+void hmp_report_open_error(const char *hmp_name, hmp_open_error hoe, PHYSFS_ErrorCode pec);
 #ifdef _WIN32
 void hmp_setvolume(hmp_file *hmp, int volume);
 int hmp_play(hmp_file *hmp, int bLoop);
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #if defined(__APPLE__) && defined(__MACH__)
@@ -47,6 +48,29 @@ typedef void (APIENTRYP PFNGLWAITSYNCPROC) (GLsync sync, GLbitfield flags, GLuin
 #define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
 #define GL_TIMEOUT_EXPIRED                0x911B
 
+/* GL_ARB_vertex_buffer_object */
+#ifndef GL_VERSION_1_5
+typedef std::ptrdiff_t GLsizeiptr;
+typedef std::ptrdiff_t GLintptr;
+
+typedef void (APIENTRYP PFNGLBINDBUFFERPROC) (GLenum target, GLuint buffer);
+typedef void (APIENTRYP PFNGLDELETEBUFFERSPROC) (GLsizei n, const GLuint *buffers);
+typedef void (APIENTRYP PFNGLGENBUFFERSPROC) (GLsizei n, GLuint *buffers);
+typedef void (APIENTRYP PFNGLBUFFERDATAPROC) (GLenum target, GLsizeiptr size, const void *data, GLenum usage);
+typedef void (APIENTRYP PFNGLBUFFERSUBDATAPROC) (GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+
+#define GL_ARRAY_BUFFER                   0x8892
+#define GL_ELEMENT_ARRAY_BUFFER           0x8893
+#define GL_STREAM_DRAW                    0x88E0
+#define GL_STATIC_DRAW                    0x88E4
+#define GL_DYNAMIC_DRAW                   0x88E8
+#endif
+
+/* GL_EXT_multi_draw_arrays */
+#ifndef GL_VERSION_1_4
+typedef void (APIENTRYP PFNGLMULTIDRAWELEMENTSPROC) (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount);
+#endif
+
 /* GL_EXT_texture */
 #ifndef GL_VERSION_1_1
 #ifdef GL_EXT_texture
@@ -71,6 +95,15 @@ extern PFNGLDELETESYNCPROC glDeleteSyncFunc;
 extern PFNGLCLIENTWAITSYNCPROC glClientWaitSyncFunc;
 extern GLfloat ogl_maxanisotropy;
 
+extern bool ogl_have_ARB_vertex_buffer_object;
+extern PFNGLBINDBUFFERPROC glBindBufferFunc;
+extern PFNGLDELETEBUFFERSPROC glDeleteBuffersFunc;
+extern PFNGLGENBUFFERSPROC glGenBuffersFunc;
+extern PFNGLBUFFERDATAPROC glBufferDataFunc;
+extern PFNGLBUFFERSUBDATAPROC glBufferSubDataFunc;
+/* May be null even if ogl_have_ARB_vertex_buffer_object is set */
+extern PFNGLMULTIDRAWELEMENTSPROC glMultiDrawElementsFunc;
+
 /* Global initialization:
  * will need an OpenGL context and intialize all function pointers.
  */
@@ -106,6 +106,31 @@ constexpr int opengl_bitmap_use_dst_canvas = -1;
 bool ogl_ubitmapm_cs(grs_canvas &, int x, int y,int dw, int dh, grs_bitmap &bm, int c);
 bool ogl_ubitmapm_cs(grs_canvas &, int x, int y,int dw, int dh, grs_bitmap &bm, const ogl_colors::array_type &c);
 bool ogl_ubitmapm_cs(grs_canvas &, int x, int y, int dw, int dh, grs_bitmap &bm, const ogl_colors::array_type &c, bool fill);
+
+/* Collect bitmaps which would otherwise be drawn one at a time by
+ * ogl_ubitmapm_cs, and draw each run of bitmaps that share a texture
+ * with one call.  Used for strings, where every glyph is a sub-bitmap
+ * of the font's texture.
+ */
+class ogl_bitmap_batch
+{
+	static constexpr std::size_t vertices_per_quad{6};
+	static constexpr std::size_t max_quads{64};
+	grs_bitmap *run_bitmap{};
+	std::size_t quads{};
+	std::array<GLfloat, max_quads * vertices_per_quad * 2> vertices, texcoords;
+	std::array<GLfloat, max_quads * vertices_per_quad * 4> colors;
+public:
+	ogl_bitmap_batch() = default;
+	ogl_bitmap_batch(const ogl_bitmap_batch &) = delete;
+	ogl_bitmap_batch &operator=(const ogl_bitmap_batch &) = delete;
+	~ogl_bitmap_batch()
+	{
+		flush();
+	}
+	void add(grs_canvas &, int x, int y, int dw, int dh, grs_bitmap &bm, const ogl_colors::array_type &c);
+	void flush();
+};
 bool ogl_ubitblt_cs(grs_canvas &, int dw, int dh, int dx, int dy, int sx, int sy);
 bool ogl_ubitblt_i(unsigned dw, unsigned dh, unsigned dx, unsigned dy, unsigned sw, unsigned sh, unsigned sx, unsigned sy, const grs_bitmap &src, grs_bitmap &dest, opengl_texture_filter texfilt);
 bool ogl_ubitblt(unsigned w, unsigned h, unsigned dx, unsigned dy, unsigned sx, unsigned sy, const grs_bitmap &src, grs_bitmap &dest);
@@ -114,10 +139,36 @@ color_palette_index ogl_ugpixel(const grs_bitmap &bitmap, unsigned x, unsigned y
 void ogl_ulinec(grs_canvas &, int left, int top, int right, int bot, int c);
 void _g3_draw_tmap_2(grs_canvas &, std::span<g3_draw_tmap_point *const> pointlist, std::span<const g3s_uvl, 4> uvl_list, std::span<const g3s_lrgb, 4> light_rgb, grs_bitmap &bmbot, grs_bitmap &bm, texture2_rotation_low orient, tmap_drawer_type tmap_drawer_ptr);
 
+/* Level geometry drawn from persistent buffers (-gl_levelvbo).  Sides
+ * queued with ogl_queue_level_side are drawn by ogl_draw_level_geometry,
+ * batched by texture.
+ */
+struct ogl_level_side_faces
+{
+	/* Draw the whole side as a quad.  Otherwise, draw the triangles of
+	 * the side's split which are set.
+	 */
+	bool quad;
+	bool face0, face1;
+};
+void ogl_invalidate_level_geometry();
+void ogl_queue_level_side(segnum_t segnum, sidenum_t sidenum, ogl_level_side_faces faces, const std::array<uvl, 4> &uvls, texture2_rotation_low orient, const std::array<g3s_lrgb, 4> &light, grs_bitmap &bm, grs_bitmap *bm2);
+void ogl_draw_level_geometry();
+
+/* HUD bitmaps packed into shared textures (-gl_hudatlas).  Returns the
+ * atlas sub-bitmap for bm, or bm itself if it was not packed.
+ */
+grs_bitmap &ogl_hud_atlas_bitmap(grs_bitmap &bm);
+void ogl_free_hud_atlas();
+
 }
 #ifdef DXX_BUILD_DESCENT
 namespace dsx {
 void ogl_cache_level_textures();
+/* Prepare a new frame of level geometry, building the buffers if the
+ * level changed.  Returns false if -gl_levelvbo is not in use.
+ */
+bool ogl_begin_level_geometry();
 }
 #endif
 
@@ -0,0 +1,36 @@
+/*
+ * This file is part of the DXX-Rebirth project <https://www.dxx-rebirth.com/>.
+ * It is copyright by its individual contributors, as recorded in the
+ * project's Git history.  See COPYING.txt at the top level for license
+ * terms and a link to the Git history.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace dcx {
+
+/* Call `job(context, i)` once for every `i` in [0, count), spreading the
+ * calls across a pool of worker threads.  The calling thread also runs
+ * items, and the function returns only after every call has finished.
+ *
+ * Items may run in any order and on any thread, so `job` must only write
+ * state that belongs to item `i`.  Callers that need deterministic results
+ * should store per-item results and consume them serially afterward.
+ */
+void run_parallel(std::size_t count, void (*job)(void *context, std::size_t i), void *context);
+
+template <typename F>
+void run_parallel(const std::size_t count, F &&f)
+{
+	run_parallel(count, [](void *const context, const std::size_t i) {
+		(*static_cast<F *>(context))(i);
+	}, &f);
+}
+
+/* Number of threads, including the caller, that `run_parallel` uses.
+ */
+unsigned get_worker_thread_count();
+
+}
@@ -227,6 +227,9 @@ int ai_door_is_openable(
 	const shared_segment &segp, sidenum_t sidenum);
 player_visibility_state player_is_visible_from_object(const d_robot_info_array &Robot_info, vmobjptridx_t objp, vms_vector &pos, fix field_of_view, const vms_vector &vec_to_player);
 extern void ai_reset_all_paths(void);   // Reset all paths.  Call at the start of a level.
+void ai_path_free(vmobjptridx_t objp);
+unsigned ai_path_pool_high_water();
+void ai_path_pool_rebuild();
 
 #if DXX_BUILD_DESCENT == 2
 // In escort.c
@@ -286,11 +289,6 @@ extern void special_reactor_stuff(void);
 namespace dcx {
 struct point_seg_array_t : public std::array<point_seg, MAX_POINT_SEGS> {};
 extern point_seg_array_t        Point_segs;
-extern point_seg_array_t::iterator        Point_segs_free_ptr;
-static inline std::size_t operator-(point_seg_array_t::iterator i, point_seg_array_t &p)
-{
-	return std::distance(p.begin(), i);
-}
 
 enum class create_path_random_flag : bool
 {
@@ -329,6 +327,7 @@ void create_path_to_segment(vmobjptridx_t objp, const robot_info &robptr, unsign
 void create_path_to_believed_player_segment(vmobjptridx_t objp, const robot_info &robptr, unsigned max_length, create_path_safety_flag safety_flag);
 void create_path_to_guidebot_player_segment(vmobjptridx_t objp, const robot_info &robptr, unsigned max_length, create_path_safety_flag safety_flag);
 std::pair<create_path_result, unsigned> create_path_points(vmobjptridx_t objp, const robot_info *robptr, vcsegidx_t start_seg, icsegidx_t end_seg, point_seg_array_t::iterator point_segs, unsigned max_depth, create_path_random_flag random_flag, create_path_safety_flag safety_flag, icsegidx_t avoid_seg);
+void invalidate_ai_path_heuristic();
 
 void ai_save_state(PHYSFS_File * fp);
 int ai_restore_state(const d_robot_info_array &Robot_info, NamedPHYSFS_File fp, int version, physfsx_endian swap);
@@ -9,10 +9,153 @@
 #include "dxxsconf.h"
 #include "object.h"
 #include "morph.h"
+#include <bit>
+#include <cassert>
+#include <limits>
+#include <utility>
 
 #ifdef DXX_BUILD_DESCENT
 namespace dcx {
 
+/* One bit per object slot, set while the slot is allocated.  Loops that
+ * only care about live objects use this to skip unused slots without
+ * loading the (large) object structure for each one.
+ */
+class object_slot_bitmap
+{
+	using word_type = uint64_t;
+	static constexpr std::size_t bits_per_word{std::numeric_limits<word_type>::digits};
+	std::array<word_type, (MAX_OBJECTS + bits_per_word - 1) / bits_per_word> words{};
+public:
+	void set(const objnum_t i)
+	{
+		words[i / bits_per_word] |= word_type{1} << (i % bits_per_word);
+	}
+	void reset(const objnum_t i)
+	{
+		words[i / bits_per_word] &= ~(word_type{1} << (i % bits_per_word));
+	}
+	void clear()
+	{
+		words = {};
+	}
+	bool test(const objnum_t i) const
+	{
+		return words[i / bits_per_word] & (word_type{1} << (i % bits_per_word));
+	}
+	/* Return the first set slot in [i, end), or `end` if there is none.
+	 */
+	std::size_t find_next(std::size_t i, const std::size_t end) const
+	{
+		while (i < end)
+		{
+			const auto w{words[i / bits_per_word] >> (i % bits_per_word)};
+			if (w)
+			{
+				i += std::countr_zero(w);
+				return std::min(i, end);
+			}
+			i = (i / bits_per_word + 1) * bits_per_word;
+		}
+		return end;
+	}
+	/* Return the last set slot in [0, end), or `end` if there is none.
+	 */
+	std::size_t find_last(const std::size_t end) const
+	{
+		for (std::size_t w = (end + bits_per_word - 1) / bits_per_word; w--;)
+		{
+			auto word{words[w]};
+			if (const std::size_t tail{end % bits_per_word}; tail && w == end / bits_per_word)
+				word &= (word_type{1} << tail) - 1;
+			if (word)
+				return w * bits_per_word + (bits_per_word - 1 - std::countl_zero(word));
+		}
+		return end;
+	}
+};
+
+/* The object types that free_object_slots may delete to make room for new
+ * objects, in the order that it prefers to delete them.
+ */
+enum class reclaimable_object_type : uint8_t
+{
+	debris,
+	fireball,
+	weapon,
+	None,
+};
+
+/* A list of the live objects of each reclaimable type, oldest first.  The
+ * links are stored by object number beside the object array, so adding or
+ * removing an object does not touch any other object structure.
+ *
+ * An object joins a list when it is created, and leaves when its slot is
+ * freed.  Code that overwrites an existing object in place (such as network
+ * object sync) does not move it to a different list, so users must check
+ * the type of each object they visit.
+ */
+class reclaimable_object_lists
+{
+	static constexpr std::size_t list_count{static_cast<std::size_t>(reclaimable_object_type::None)};
+	struct link
+	{
+		objnum_t prev, next;
+	};
+	std::array<link, MAX_OBJECTS> links;
+	std::array<reclaimable_object_type, MAX_OBJECTS> membership;
+	std::array<objnum_t, list_count> heads, tails;
+	std::array<unsigned, list_count> counts;
+public:
+	static constexpr objnum_t end_of_list{std::numeric_limits<objnum_t>::max()};
+	reclaimable_object_lists()
+	{
+		clear();
+	}
+	void clear()
+	{
+		membership.fill(reclaimable_object_type::None);
+		heads.fill(end_of_list);
+		tails.fill(end_of_list);
+		counts = {};
+	}
+	void push_back(const objnum_t i, const reclaimable_object_type t)
+	{
+		assert(membership[i] == reclaimable_object_type::None);
+		if (t == reclaimable_object_type::None)
+			return;
+		const std::size_t l{static_cast<std::size_t>(t)};
+		membership[i] = t;
+		links[i] = {tails[l], end_of_list};
+		(tails[l] == end_of_list ? heads[l] : links[tails[l]].next) = i;
+		tails[l] = i;
+		++counts[l];
+	}
+	void remove(const objnum_t i)
+	{
+		const auto t{std::exchange(membership[i], reclaimable_object_type::None)};
+		if (t == reclaimable_object_type::None)
+			return;
+		const std::size_t l{static_cast<std::size_t>(t)};
+		const auto &k{links[i]};
+		(k.prev == end_of_list ? heads[l] : links[k.prev].next) = k.next;
+		(k.next == end_of_list ? tails[l] : links[k.next].prev) = k.prev;
+		--counts[l];
+	}
+	objnum_t front(const reclaimable_object_type t) const
+	{
+		return heads[static_cast<std::size_t>(t)];
+	}
+	objnum_t next(const objnum_t i) const
+	{
+		return links[i].next;
+	}
+	unsigned size(const reclaimable_object_type t) const
+	{
+		return counts[static_cast<std::size_t>(t)];
+	}
+};
+
 struct d_level_unique_morph_object_state
 {
 	std::array<morph_data::ptr, 5> morph_objects;
@@ -26,6 +169,11 @@ namespace dsx {
 struct d_level_unique_object_state
 {
 	unsigned num_objects{0};
+	/* Number of object slots that may be allocated on this level.  This is
+	 * at most `MAX_OBJECTS`, and is recomputed whenever the free list is
+	 * rebuilt.
+	 */
+	unsigned object_limit{LEGACY_MAX_OBJECTS};
 	/* `accumulated_robots` counts robots present at level entry and
 	 * robots added later via materialization centers / boss gating.  It
 	 * never decreases, so it is not a shortcut for counting the number
@@ -40,6 +188,8 @@ struct d_level_unique_object_state
 	d_guided_missile_indices Guided_missile;
 #endif
 	std::array<imobjidx_t, MAX_OBJECTS> free_obj_list = init_object_number_array<imobjidx_t>(std::make_index_sequence<MAX_OBJECTS>());
+	object_slot_bitmap allocated_objects;
+	reclaimable_object_lists reclaimable_objects;
 	object_array Objects;
 	d_level_unique_boss_state BossState;
 	d_level_unique_control_center_state ControlCenterState;
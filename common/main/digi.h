@@ -117,6 +117,8 @@ void digi_kill_sound_linked_to_object(vcobjptridx_t);
 void digi_play_sample_3d(sound_effect soundno, sound_pan angle, int volume); // Volume from 0-0x7fff
 
 extern void digi_init_sounds();
+// Prepare every loaded sound for playback, so that first use does not stall.
+void digi_preload_sounds();
 extern void digi_sync_sounds();
 
 extern void digi_set_digi_volume( int dvolume );
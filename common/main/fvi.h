@@ -25,6 +25,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 
 #pragma once
 
+#include <span>
 #include "dsx-ns.h"
 #include "vecmat.h"
 
@@ -131,6 +132,35 @@ struct fvi_query
 [[nodiscard]]
 fvi_hit_type find_vector_intersection(fvi_query fq, segnum_t startseg, fix rad, fvi_info &hit_data);
 
+//One query for find_vector_intersections: the arguments that would
+//otherwise be passed to find_vector_intersection.
+struct fvi_batch_query
+{
+	fvi_query fq;
+	segnum_t startseg;
+	fix rad;
+};
+
+struct fvi_batch_result
+{
+	fvi_hit_type hit_type;
+	fvi_info hit_data;
+};
+
+enum class fvi_batch_parallel : bool
+{
+	no,
+	yes,
+};
+
+//Run find_vector_intersection for every element of `queries`, storing
+//the result of queries[i] in results[i].  The results are identical to
+//calling find_vector_intersection for each query in turn.  Queries that
+//share a start segment and start point are run together, so the start
+//point is checked once for the group.  If `parallel` is yes, the groups
+//are spread across the worker pool.
+void find_vector_intersections(std::span<const fvi_batch_query> queries, std::span<fvi_batch_result> results, fvi_batch_parallel parallel);
+
 //finds the uv coords of the given point on the given seg & side
 //fills in u & v. if l is non-NULL fills it in also
 [[nodiscard]]
@@ -139,4 +169,8 @@ fvi_hitpoint find_hitpoint_uv(const vms_vector &pnt, const cscusegment seg, side
 
 //Returns true if the object is through any walls
 sphere_intersects_wall_result sphere_intersects_wall(fvcsegptridx &vcsegptridx, fvcvertptr &vcvertptr, const vms_vector &pnt, vcsegptridx_t seg, fix rad);
+
+//Discard the per-level face data used by the wall tests.  Call when a
+//new level is loaded.
+void invalidate_fvi_side_data();
 #endif
@@ -23,8 +23,20 @@
 namespace dcx {
 
 // Movement types
-constexpr std::integral_constant<std::size_t, 350> MAX_OBJECTS{};
-constexpr std::integral_constant<std::size_t, MAX_OBJECTS - 20> MAX_USED_OBJECTS{};
+/* `MAX_OBJECTS` is the storage capacity of the object array.  The number of
+ * slots that may actually be allocated is
+ * `d_level_unique_object_state::object_limit`, which is chosen per level.
+ * `LEGACY_MAX_OBJECTS` is the capacity used by older releases.  Games that
+ * exchange object numbers with other programs (multiplayer, demos) never
+ * allocate beyond it.
+ */
+constexpr std::integral_constant<std::size_t, 1000> MAX_OBJECTS{};
+constexpr std::integral_constant<std::size_t, 350> LEGACY_MAX_OBJECTS{};
+/* Number of slots that `object_move_all` tries to keep free by culling
+ * expendable objects when the table is nearly full.
+ */
+constexpr std::integral_constant<std::size_t, 20> RESERVED_FREE_OBJECTS{};
+constexpr std::integral_constant<unsigned, 400> DEFAULT_OBJECT_HEADROOM{};
 struct d_level_unique_control_center_state;
 
 // Render types
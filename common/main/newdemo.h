@@ -43,6 +43,9 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #define ND_STATE_ONEFRAMEFORWARD	6
 #define ND_STATE_ONEFRAMEBACKWARD	7
 
+// Number of frames that one press of the demo seek keys moves
+#define ND_SEEK_JUMP_FRAMES		900
+
 #define DEMO_DIR                "demos/"
 #define DEMO_EXT		"dem"
 extern const std::array<file_extension_t, 1> demo_file_extensions;
@@ -84,6 +87,7 @@ void newdemo_record_viewer_object(vcobjptridx_t obj);
 icobjptridx_t newdemo_find_object(object_signature_t signature);
 void newdemo_record_kill_sound_linked_to_object(vcobjptridx_t);
 void newdemo_start_playback(const char *filename);
+void newdemo_analyze(const char *filename);
 void newdemo_record_morph_frame(vcobjptridx_t);
 }
 void newdemo_record_sound_3d_once(sound_effect soundno, sound_pan angle, int volume );
@@ -144,6 +148,7 @@ extern window_event_result newdemo_playback_one_frame();
 #ifdef DXX_BUILD_DESCENT
 namespace dsx {
 extern window_event_result newdemo_goto_end(int to_rewrite);
+window_event_result newdemo_seek_frames(int frames);
 }
 #endif
 extern window_event_result newdemo_goto_beginning();
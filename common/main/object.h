@@ -759,6 +759,56 @@ window_event_result dead_player_frame(const d_robot_info_array &Robot_info);
 window_event_result game_move_all_objects(const d_level_shared_robot_info_state &LevelSharedRobotInfoState);     // moves all objects
 window_event_result endlevel_move_all_objects(const d_level_shared_robot_info_state &LevelSharedRobotInfoState);
 
+// An object found by find_objects_near, with its squared distance from
+// the center of the query.
+struct nearby_object
+{
+	objnum_t objnum;
+	vm_distance_squared distance;
+};
+
+enum class nearby_object_order : bool
+{
+	objnum,		// the order in which the object array would visit them
+	distance,	// nearest first; equal distances in objnum order
+};
+
+// Storage for the results of find_objects_near, borrowed from a pool so
+// that repeated searches reuse it instead of allocating.  Each live
+// instance holds its own vector, so a search made while the results of
+// another are still in use (an explosion that sets off another) is safe.
+class nearby_object_buffer
+{
+	std::vector<nearby_object> objects;
+public:
+	nearby_object_buffer();
+	~nearby_object_buffer();
+	nearby_object_buffer(const nearby_object_buffer &) = delete;
+	nearby_object_buffer &operator=(const nearby_object_buffer &) = delete;
+	operator std::vector<nearby_object> &()
+	{
+		return objects;
+	}
+	auto begin() const
+	{
+		return objects.begin();
+	}
+	auto end() const
+	{
+		return objects.end();
+	}
+};
+
+// Find the objects within `radius` of `center`, by searching outward
+// from `start_seg` through segments that overlap the sphere.  This finds
+// every object that object_to_object_visibility could see from a point
+// in `start_seg`, without visiting every object in the level.
+void find_objects_near(std::vector<nearby_object> &result, vcsegptridx_t start_seg, const vms_vector &center, vm_distance radius, nearby_object_order order);
+
+// Discard the segment bounds kept by find_objects_near.  Call when a
+// new level is loaded.
+void invalidate_segment_bounds();
+
 }
 
 namespace dcx {
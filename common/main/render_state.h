@@ -28,6 +28,9 @@ struct render_state_t
 		std::vector<distant_object> objects;
 		uint16_t Seg_depth{0};		//depth for this seg in Render_list
 		bool processed = false;		//whether this entry has been processed
+#if !DXX_USE_OGL
+		bool occluded = false;		//whether the occlusion buffer hides this segment's sides
+#endif
 		rect render_window;
 	};
 	unsigned N_render_segs{0};
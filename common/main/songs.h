@@ -66,6 +66,7 @@ int songs_play_file(char *filename, int repeat, void (*hook_finished_track)());
 namespace dsx {
 void songs_play_song(song_number songnum, int repeat);
 void songs_play_level_song(int levelnum, int offset);
+void songs_prefetch_level_song(int levelnum);
 
 //stop any songs - midi, redbook or jukebox - that are currently playing
 }
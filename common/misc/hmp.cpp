@@ -687,17 +687,19 @@ DEFINE_SERIAL_CONST_UDT_TO_MESSAGE(midhdr, m, (magic_header, m.num_trks, m.time_
 
 }
 
+void hmp_report_open_error(const char *const hmp_name, const hmp_open_error hoe, const PHYSFS_ErrorCode pec)
+{
+	if (underlying_value(hoe) <= static_cast<unsigned>(hmp_open_error::physfs_read_track_data))
+		con_printf(CON_CRITICAL, "Failed to read HMP music %s: hmp_open_error=%u; PHYSFS_ErrorCode=%u/%s", hmp_name, underlying_value(hoe), pec, PHYSFS_getErrorByCode(pec));
+	else
+		con_printf(CON_CRITICAL, "Failed to read HMP music %s: hmp_open_error=%u", hmp_name, underlying_value(hoe));
+}
+
 hmpmid_result hmp2mid(const char *hmp_name)
 {
 	auto &&[hmp, hoe, pec] = hmp_open(hmp_name);
 	if (!hmp)
-	{
-		if (underlying_value(hoe) <= static_cast<unsigned>(hmp_open_error::physfs_read_track_data))
-			con_printf(CON_CRITICAL, "Failed to read HMP music %s: hmp_open_error=%u; PHYSFS_ErrorCode=%u/%s", hmp_name, underlying_value(hoe), pec, PHYSFS_getErrorByCode(pec));
-		else
-			con_printf(CON_CRITICAL, "Failed to read HMP music %s: hmp_open_error=%u", hmp_name, underlying_value(hoe));
-		return {std::vector<uint8_t>{}, hoe};
-	}
+		return {std::vector<uint8_t>{}, hoe, pec};
 
 	const midhdr mh(hmp.get());
 	std::vector<uint8_t> midbuf;
@@ -717,7 +719,7 @@ hmpmid_result hmp2mid(const char *hmp_name)
 		serial::writer::be_bytebuffer bbmi{&midbuf[midtrklenpos]};
 		serial::process_buffer(bbmi, static_cast<int32_t>(size_after - size_before));
 	}
-	return {midbuf, hmp_open_error::None};
+	return {std::move(midbuf), hmp_open_error::None, PHYSFS_ERR_OK};
 }
 
 }
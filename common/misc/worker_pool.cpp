@@ -0,0 +1,151 @@
+/*
+ * This file is part of the DXX-Rebirth project <https://www.dxx-rebirth.com/>.
+ * It is copyright by its individual contributors, as recorded in the
+ * project's Git history.  See COPYING.txt at the top level for license
+ * terms and a link to the Git history.
+ */
+
+/*
+ *
+ * Small fixed pool of worker threads for data-parallel loops.
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "worker_pool.h"
+#include "args.h"
+
+namespace dcx {
+
+namespace {
+
+/* The pool is only useful for short bursts of independent work, so more
+ * threads than this would spend more time waking up than working.
+ */
+constexpr unsigned maximum_worker_threads{8};
+
+class worker_pool
+{
+	std::mutex mutex;
+	std::condition_variable work_ready, work_done;
+	std::vector<std::thread> threads;
+	/* Incremented for each call to `run`, so that workers can tell a new
+	 * job from a spurious wakeup.
+	 */
+	unsigned generation{};
+	unsigned busy_workers{};
+	bool stopping{};
+	void (*job)(void *, std::size_t){};
+	void *context{};
+	std::size_t count{};
+	std::atomic<std::size_t> next_item{};
+	void run_items()
+	{
+		for (std::size_t i; (i = next_item.fetch_add(1, std::memory_order_relaxed)) < count;)
+			job(context, i);
+	}
+	void worker_main();
+public:
+	explicit worker_pool(unsigned helper_threads);
+	~worker_pool();
+	unsigned thread_count() const
+	{
+		return threads.size() + 1;
+	}
+	void run(std::size_t count, void (*job)(void *, std::size_t), void *context);
+};
+
+worker_pool::worker_pool(const unsigned helper_threads)
+{
+	threads.reserve(helper_threads);
+	for (unsigned i = 0; i < helper_threads; ++i)
+		threads.emplace_back(&worker_pool::worker_main, this);
+}
+
+worker_pool::~worker_pool()
+{
+	{
+		std::lock_guard lock(mutex);
+		stopping = true;
+	}
+	work_ready.notify_all();
+	for (auto &t : threads)
+		t.join();
+}
+
+void worker_pool::worker_main()
+{
+	unsigned seen_generation{};
+	for (;;)
+	{
+		{
+			std::unique_lock lock(mutex);
+			work_ready.wait(lock, [this, seen_generation] { return stopping || generation != seen_generation; });
+			if (stopping)
+				return;
+			seen_generation = generation;
+		}
+		run_items();
+		std::lock_guard lock(mutex);
+		if (!--busy_workers)
+			work_done.notify_one();
+	}
+}
+
+void worker_pool::run(const std::size_t n, void (*const f)(void *, std::size_t), void *const c)
+{
+	{
+		std::lock_guard lock(mutex);
+		job = f;
+		context = c;
+		count = n;
+		next_item.store(0, std::memory_order_relaxed);
+		busy_workers = threads.size();
+		++generation;
+	}
+	work_ready.notify_all();
+	run_items();
+	std::unique_lock lock(mutex);
+	work_done.wait(lock, [this] { return !busy_workers; });
+}
+
+worker_pool &get_worker_pool()
+{
+	static worker_pool pool{[]() -> unsigned {
+		unsigned n{CGameArg.SysWorkerThreads};
+		if (!n)
+			n = std::thread::hardware_concurrency();
+		return std::clamp(n, 1u, maximum_worker_threads) - 1;
+	}()};
+	return pool;
+}
+
+}
+
+void run_parallel(const std::size_t count, void (*const job)(void *, std::size_t), void *const context)
+{
+	if (count > 1)
+	{
+		auto &pool{get_worker_pool()};
+		if (pool.thread_count() > 1)
+		{
+			pool.run(count, job, context);
+			return;
+		}
+	}
+	for (std::size_t i = 0; i < count; ++i)
+		job(context, i);
+}
+
+unsigned get_worker_thread_count()
+{
+	return get_worker_pool().thread_count();
+}
+
+}
@@ -0,0 +1,94 @@
+#include "digi_mixer_fir.h"
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Rebirth digi_mixer_fir
+#include <boost/test/unit_test.hpp>
+
+using namespace dcx::soundblaster16_filter;
+
+namespace {
+
+/* The direct convolution that upsample_filter replaced: insert `factor - 1`
+ * zeros after each sample, then convolve with every tap of the kernel.
+ */
+std::vector<int16_t> reference_upsample_filter(const std::span<const uint8_t> input, const std::size_t factor, const filter_coefficients &coeffs)
+{
+	std::vector<int8_t> signal(input.size() * factor);
+	for (std::size_t i = 0; i < input.size(); ++i)
+		signal[i * factor] = int16_t{input[i]} + INT8_MIN;
+	std::vector<int16_t> output(signal.size());
+	for (std::size_t nn = 0; nn < signal.size(); ++nn)
+	{
+		const std::size_t min_idx = (nn + 1 > FILTER_LEN ? nn + 1 - FILTER_LEN : 0u);
+		int32_t cur_output{0};
+		for (std::size_t kk = min_idx; kk <= nn; ++kk)
+			cur_output += int32_t{signal[kk]} * coeffs[nn - kk];
+		output[nn] = static_cast<int16_t>(cur_output >> 8);
+	}
+	return output;
+}
+
+void check_matches_reference(const std::span<const uint8_t> input, const std::size_t factor, const filter_coefficients &coeffs)
+{
+	const auto expected{reference_upsample_filter(input, factor, coeffs)};
+	std::vector<int16_t> actual(input.size() * factor);
+	upsample_filter(input, factor, coeffs, actual);
+	BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+/* Deterministic pseudo-random samples, so that failures are reproducible.
+ */
+std::vector<uint8_t> build_noise(const std::size_t length)
+{
+	std::vector<uint8_t> r(length);
+	uint32_t state{12345};
+	for (auto &i : r)
+	{
+		state = state * 1103515245 + 12345;
+		i = state >> 24;
+	}
+	return r;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(upsample_filter_empty)
+{
+	std::vector<int16_t> output;
+	upsample_filter({}, 4, coeffs_quarterband, output);
+	BOOST_TEST(output.empty());
+}
+
+/* Inputs shorter than the kernel only ever use part of it.
+ */
+BOOST_AUTO_TEST_CASE(upsample_filter_short)
+{
+	const auto input{build_noise(5)};
+	check_matches_reference(input, 4, coeffs_quarterband);
+	check_matches_reference(input, 2, coeffs_halfband);
+}
+
+BOOST_AUTO_TEST_CASE(upsample_filter_noise_quarterband)
+{
+	check_matches_reference(build_noise(4096), 4, coeffs_quarterband);
+}
+
+BOOST_AUTO_TEST_CASE(upsample_filter_noise_halfband)
+{
+	check_matches_reference(build_noise(4096), 2, coeffs_halfband);
+}
+
+/* Full scale square waves drive the halfband filter past the range of
+ * int16_t.  The result must still truncate exactly as before.
+ */
+BOOST_AUTO_TEST_CASE(upsample_filter_full_scale)
+{
+	std::vector<uint8_t> input(256);
+	for (std::size_t i = 0; i < input.size(); ++i)
+		input[i] = (i & 1) ? UINT8_MAX : 0;
+	check_matches_reference(input, 4, coeffs_quarterband);
+	check_matches_reference(input, 2, coeffs_halfband);
+}
@@ -911,6 +911,7 @@ void gr_close()
 {
 	ogl_brightness_r = ogl_brightness_g = ogl_brightness_b = 0;
 
+	ogl_free_hud_atlas();
 	if (gl_initialized)
 	{
 		ogl_smash_texture_list_internal();
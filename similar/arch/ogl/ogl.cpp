@@ -47,6 +47,7 @@
 #include "u_mem.h"
 
 #include "segment.h"
+#include "gameseg.h"
 #include "textures.h"
 #include "texmerge.h"
 #include "effects.h"
@@ -61,6 +62,7 @@
 #include "gauges.h"
 #include "object.h"
 #include "args.h"
+#include "ogl_extensions.h"
 
 #include "compiler-range_for.h"
 #include "d_levelstate.h"
@@ -68,8 +70,11 @@
 #include "partial_range.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 using std::max;
 
 //change to 1 for lots of spew.
@@ -136,7 +141,21 @@ static std::array<std::unique_ptr<GLfloat[]>, 3> secondary_lva;
 static int r_polyc,r_tpolyc,r_bitmapc,r_ubitbltc;
 #define f2glf(x) (f2fl(x))
 
-#define OGL_BINDTEXTURE(a) glBindTexture(GL_TEXTURE_2D, a);
+/* Handle last bound to GL_TEXTURE_2D, so that consecutive draws from the
+ * same texture (or the same atlas page) skip the bind.  Reset whenever a
+ * texture is deleted, since glGenTextures may reuse the handle.
+ */
+static GLuint ogl_bound_texture;
+
+static void ogl_bind_texture(const GLuint handle)
+{
+	if (ogl_bound_texture == handle)
+		return;
+	ogl_bound_texture = handle;
+	glBindTexture(GL_TEXTURE_2D, handle);
+}
+
+#define OGL_BINDTEXTURE(a) ogl_bind_texture(a);
 
 /* I assume this ought to be >= MAX_BITMAP_FILES in piggy.h? */
 static std::array<ogl_texture, 20000> ogl_texture_list;
@@ -147,6 +166,7 @@ static int ogl_texture_list_cur;
 #define GL_TEXTURE0_ARB 0x84C0
 static int ogl_loadtexture(const palette_array_t &, const uint8_t *data, int dxo, int dyo, ogl_texture &tex, int bm_flags, int data_format, opengl_texture_filter texfilt, bool texanis, bool edgepad) dxx_compiler_attribute_nonnull();
 static void ogl_freetexture(ogl_texture &gltexture);
+static void ogl_free_level_geometry();
 
 static void ogl_loadbmtexture(grs_bitmap &bm, bool edgepad)
 {
@@ -265,6 +285,8 @@ void ogl_smash_texture_list_internal(void){
 	circle_va.reset();
 	disk_va.reset();
 	secondary_lva = {};
+	ogl_free_level_geometry();
+	ogl_bound_texture = 0;
 	range_for (auto &i, ogl_texture_list)
 	{
 		if (i.handle>0){
@@ -419,8 +441,452 @@ static void ogl_cache_weapon_textures(const d_vclip_array &Vclip, const weapon_i
 	}
 }
 
+namespace dcx {
+
+namespace {
+
+/* Level geometry buffers used by render_mine when -gl_levelvbo is given.
+ * Each side owns 4 vertices starting at 4 * slot and 12 indices starting
+ * at 12 * slot, where slot = 6 * segnum + sidenum.  The indices are the
+ * triangles (0,1,2) (0,2,3), which also cover the quad, followed by the
+ * triangles (0,1,3) (1,2,3) of a side split along 1-3.  Positions and
+ * indices are uploaded once per level.  Texture coordinates are rewritten only
+ * for sides whose uvls or overlay rotation changed since they were last
+ * drawn (sliding textures), and colors are streamed once per frame for
+ * the range of sides that were queued.
+ */
+struct ogl_level_texcoord
+{
+	std::array<GLfloat, 2> base, overlay;
+	constexpr bool operator==(const ogl_level_texcoord &) const = default;
+};
+
+using ogl_level_side_texcoords = std::array<ogl_level_texcoord, 4>;
+using ogl_level_side_colors = std::array<std::array<GLubyte, 4>, 4>;
+
+struct ogl_level_batch
+{
+	grs_bitmap *bm;
+	std::size_t next_index;
+	std::vector<GLsizei> counts;
+	std::vector<const GLvoid *> offsets;
+};
+
+/* One batch per bitmap.  Batches are reused across frames so that their
+ * vectors keep their capacity.
+ */
+class ogl_level_batch_list
+{
+	std::vector<ogl_level_batch> batches;
+	std::unordered_map<const grs_bitmap *, std::size_t> index;
+	std::size_t used{};
+public:
+	void clear()
+	{
+		index.clear();
+		used = 0;
+	}
+	void add(grs_bitmap &bm, const std::size_t first_index, const GLsizei count)
+	{
+		const auto &&[i, inserted] = index.try_emplace(&bm, used);
+		if (inserted)
+		{
+			if (used == batches.size())
+				batches.emplace_back();
+			auto &b = batches[used++];
+			b.bm = &bm;
+			b.counts.clear();
+			b.offsets.clear();
+		}
+		auto &b = batches[i->second];
+		if (!b.counts.empty() && b.next_index == first_index)
+			/* Adjacent faces with the same texture share one range. */
+			b.counts.back() += count;
+		else
+		{
+			b.counts.emplace_back(count);
+			b.offsets.emplace_back(reinterpret_cast<const GLvoid *>(first_index * sizeof(GLuint)));
+		}
+		b.next_index = first_index + count;
+	}
+	std::span<ogl_level_batch> range()
+	{
+		return std::span(batches).first(used);
+	}
+};
+
+enum ogl_level_buffer : uint8_t
+{
+	position,
+	texcoord,
+	color,
+	element,
+};
+
+struct ogl_level_geometry_state
+{
+	std::array<GLuint, 4> buffers{};
+	bool stale = true;
+	std::size_t side_count{};
+	std::unique_ptr<ogl_level_side_texcoords[]> texcoords;
+	std::unique_ptr<ogl_level_side_colors[]> colors;
+	std::size_t color_begin{}, color_end{};
+	ogl_level_batch_list base, overlay;
+};
+
+static ogl_level_geometry_state ogl_level_geometry;
+
+static constexpr std::size_t ogl_level_sides_per_segment{static_cast<std::size_t>(MAX_SIDES_PER_SEGMENT.value)};
+static constexpr std::size_t ogl_level_indices_per_side{12};
+
+static constexpr std::size_t ogl_level_side_slot(const segnum_t segnum, const sidenum_t sidenum)
+{
+	return static_cast<std::size_t>(segnum) * ogl_level_sides_per_segment + static_cast<std::size_t>(sidenum);
+}
+
+static ogl_level_side_texcoords ogl_build_level_texcoords(const std::array<uvl, 4> &uvls, const texture2_rotation_low orient)
+{
+	ogl_level_side_texcoords result;
+	for (auto &&[t, uvl] : zip(result, uvls))
+	{
+		const GLfloat uf = f2glf(uvl.u), vf = f2glf(uvl.v);
+		t.base = {{uf, vf}};
+		switch (orient)
+		{
+			case texture2_rotation_low::_1:
+				t.overlay = {{1.0f - vf, uf}};
+				break;
+			case texture2_rotation_low::_2:
+				t.overlay = {{1.0f - uf, 1.0f - vf}};
+				break;
+			case texture2_rotation_low::_3:
+				t.overlay = {{vf, 1.0f - uf}};
+				break;
+			default:
+				t.overlay = t.base;
+				break;
+		}
+	}
+	return result;
+}
+
+static void ogl_draw_level_batches(ogl_level_batch_list &list, const bool overlay)
+{
+	glTexCoordPointer(2, GL_FLOAT, sizeof(ogl_level_texcoord), reinterpret_cast<const GLvoid *>(overlay ? offsetof(ogl_level_texcoord, overlay) : offsetof(ogl_level_texcoord, base)));
+	for (auto &b : list.range())
+	{
+		ogl_bindbmtex(*b.bm, overlay);
+		ogl_texwrap(b.bm->gltexture, GL_REPEAT);
+		if (glMultiDrawElementsFunc)
+			glMultiDrawElementsFunc(GL_TRIANGLES, b.counts.data(), GL_UNSIGNED_INT, b.offsets.data(), b.counts.size());
+		else
+			for (auto &&[count, offset] : zip(b.counts, b.offsets))
+				glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, offset);
+		r_tpolyc += b.counts.size();
+	}
+}
+
+}
+
+static void ogl_free_level_geometry()
+{
+	auto &g = ogl_level_geometry;
+	if (g.buffers[0])
+	{
+		glDeleteBuffersFunc(g.buffers.size(), g.buffers.data());
+		g.buffers = {};
+	}
+	g.stale = true;
+}
+
+void ogl_invalidate_level_geometry()
+{
+	ogl_level_geometry.stale = true;
+}
+
+void ogl_queue_level_side(const segnum_t segnum, const sidenum_t sidenum, const ogl_level_side_faces faces, const std::array<uvl, 4> &uvls, const texture2_rotation_low orient, const std::array<g3s_lrgb, 4> &light, grs_bitmap &bm, grs_bitmap *const bm2)
+{
+	auto &g = ogl_level_geometry;
+	const auto slot = ogl_level_side_slot(segnum, sidenum);
+	if (slot >= g.side_count)
+		return;
+	if (const auto t = ogl_build_level_texcoords(uvls, orient); t != g.texcoords[slot])
+	{
+		g.texcoords[slot] = t;
+		glBindBufferFunc(GL_ARRAY_BUFFER, g.buffers[ogl_level_buffer::texcoord]);
+		glBufferSubDataFunc(GL_ARRAY_BUFFER, slot * sizeof(t), sizeof(t), &t);
+		glBindBufferFunc(GL_ARRAY_BUFFER, 0);
+	}
+	for (auto &&[c, l] : zip(g.colors[slot], light))
+	{
+		const auto channel = [](const fix f) -> GLubyte {
+			return std::clamp(f2glf(f), 0.0f, 1.0f) * 255.0f + 0.5f;
+		};
+		c = {{channel(l.r), channel(l.g), channel(l.b), 255}};
+	}
+	if (g.color_begin == g.color_end)
+	{
+		g.color_begin = slot;
+		g.color_end = slot + 1;
+	}
+	else
+	{
+		g.color_begin = std::min(g.color_begin, slot);
+		g.color_end = std::max(g.color_end, slot + 1);
+	}
+	/* Select the range of this side's indices which holds the requested
+	 * faces.  See the layout described before ogl_level_texcoord.
+	 */
+	std::size_t first_index{slot * ogl_level_indices_per_side};
+	GLsizei count{6};
+	if (!faces.quad)
+	{
+		if (Segments[segnum].shared_segment::sides[sidenum].type == side_type::tri_13)
+			first_index += 6;
+		if (!faces.face0)
+			first_index += 3;
+		if (!faces.face0 || !faces.face1)
+			count = 3;
+	}
+	g.base.add(bm, first_index, count);
+	if (bm2)
+		g.overlay.add(*bm2, first_index, count);
+}
+
+void ogl_draw_level_geometry()
+{
+	auto &g = ogl_level_geometry;
+	if (g.color_begin == g.color_end)
+		return;
+	glBindBufferFunc(GL_ARRAY_BUFFER, g.buffers[ogl_level_buffer::color]);
+	glBufferSubDataFunc(GL_ARRAY_BUFFER, g.color_begin * sizeof(ogl_level_side_colors), (g.color_end - g.color_begin) * sizeof(ogl_level_side_colors), &g.colors[g.color_begin]);
+
+	/* The buffers hold world coordinates, so apply the view transform
+	 * that g3_rotate_point applies on the CPU for the other faces,
+	 * including the negated z that _g3_draw_tmap uses.
+	 */
+	const auto &m = View_matrix;
+	const std::array<GLfloat, 3> p{{f2glf(View_position.x), f2glf(View_position.y), f2glf(View_position.z)}};
+	const auto row = [&p](const vms_vector &v, const GLfloat sign) {
+		const std::array<GLfloat, 3> r{{sign * f2glf(v.x), sign * f2glf(v.y), sign * f2glf(v.z)}};
+		return std::array<GLfloat, 4>{{r[0], r[1], r[2], -(r[0] * p[0] + r[1] * p[1] + r[2] * p[2])}};
+	};
+	const auto r = row(m.rvec, 1), u = row(m.uvec, 1), f = row(m.fvec, -1);
+	const std::array<GLfloat, 16> modelview{{
+		r[0], u[0], f[0], 0,
+		r[1], u[1], f[1], 0,
+		r[2], u[2], f[2], 0,
+		r[3], u[3], f[3], 1,
+	}};
+	glMatrixMode(GL_MODELVIEW);
+	glPushMatrix();
+	glLoadMatrixf(modelview.data());
+	{
+		ogl_client_states<int, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY> cs;
+		(void)cs;
+		OGL_ENABLE(TEXTURE_2D);
+		glColorPointer(4, GL_UNSIGNED_BYTE, 0, nullptr);
+		glBindBufferFunc(GL_ARRAY_BUFFER, g.buffers[ogl_level_buffer::position]);
+		glVertexPointer(3, GL_FLOAT, 0, nullptr);
+		glBindBufferFunc(GL_ARRAY_BUFFER, g.buffers[ogl_level_buffer::texcoord]);
+		glBindBufferFunc(GL_ELEMENT_ARRAY_BUFFER, g.buffers[ogl_level_buffer::element]);
+		ogl_draw_level_batches(g.base, false);
+		/* Overlays reuse the same vertices, so GL_LEQUAL lets them pass
+		 * the depth test over their base texture.
+		 */
+		ogl_draw_level_batches(g.overlay, true);
+		glBindBufferFunc(GL_ELEMENT_ARRAY_BUFFER, 0);
+		glBindBufferFunc(GL_ARRAY_BUFFER, 0);
+	}
+	glPopMatrix();
+}
+
+}
+
 namespace dsx {
 
+namespace {
+
+static void ogl_build_level_geometry()
+{
+	auto &g = ogl_level_geometry;
+	ogl_free_level_geometry();
+	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
+	auto &Vertices = LevelSharedVertexState.get_vertices();
+	auto &vcvertptr = Vertices.vcptr;
+	g.side_count = Segments.get_count() * ogl_level_sides_per_segment;
+	g.texcoords = std::make_unique_for_overwrite<ogl_level_side_texcoords[]>(g.side_count);
+	g.colors = std::make_unique<ogl_level_side_colors[]>(g.side_count);
+	std::vector<std::array<std::array<GLfloat, 3>, 4>> positions(g.side_count);
+	std::vector<std::array<GLuint, ogl_level_indices_per_side>> elements(g.side_count);
+	range_for (const auto &&segp, vcsegptridx)
+	{
+		for (const auto sidenum : MAX_SIDES_PER_SEGMENT)
+		{
+			const auto slot = ogl_level_side_slot(segp, sidenum);
+			const auto vertnum_list = get_side_verts(segp, sidenum);
+			for (auto &&[pos, vertnum] : zip(positions[slot], vertnum_list))
+			{
+				const auto &v = *vcvertptr(vertnum);
+				pos = {{f2glf(v.x), f2glf(v.y), f2glf(v.z)}};
+			}
+			/* Both splits are stored, so that ogl_queue_level_side can
+			 * draw whichever faces render_side would draw.
+			 */
+			const GLuint base = slot * 4;
+			elements[slot] = {{
+				base, base + 1, base + 2, base, base + 2, base + 3,
+				base, base + 1, base + 3, base + 1, base + 2, base + 3,
+			}};
+			auto &uside = segp->unique_segment::sides[sidenum];
+			g.texcoords[slot] = ogl_build_level_texcoords(uside.uvls, get_texture_rotation_low(uside.tmap_num2));
+		}
+	}
+	glGenBuffersFunc(g.buffers.size(), g.buffers.data());
+	const auto upload = [](const GLenum target, const GLuint buffer, const std::size_t size, const void *const data, const GLenum usage) {
+		glBindBufferFunc(target, buffer);
+		glBufferDataFunc(target, size, data, usage);
+		glBindBufferFunc(target, 0);
+	};
+	upload(GL_ARRAY_BUFFER, g.buffers[ogl_level_buffer::position], positions.size() * sizeof(positions[0]), positions.data(), GL_STATIC_DRAW);
+	upload(GL_ARRAY_BUFFER, g.buffers[ogl_level_buffer::texcoord], g.side_count * sizeof(ogl_level_side_texcoords), g.texcoords.get(), GL_DYNAMIC_DRAW);
+	upload(GL_ARRAY_BUFFER, g.buffers[ogl_level_buffer::color], g.side_count * sizeof(ogl_level_side_colors), g.colors.get(), GL_STREAM_DRAW);
+	upload(GL_ELEMENT_ARRAY_BUFFER, g.buffers[ogl_level_buffer::element], elements.size() * sizeof(elements[0]), elements.data(), GL_STATIC_DRAW);
+	g.stale = false;
+	glmprintf((CON_DEBUG, "ogl_build_level_geometry: %zu sides", g.side_count));
+}
+
+}
+
+bool ogl_begin_level_geometry()
+{
+	if (!CGameArg.OglLevelVBO || !ogl_have_ARB_vertex_buffer_object)
+		return false;
+	auto &g = ogl_level_geometry;
+	if (g.stale)
+		ogl_build_level_geometry();
+	g.base.clear();
+	g.overlay.clear();
+	g.color_begin = g.color_end = 0;
+	return true;
+}
+
+}
+
+namespace dcx {
+
+namespace {
+
+/* HUD atlas (-gl_hudatlas): at level start, small gauge bitmaps are copied
+ * into shared pages and drawn as sub-bitmaps of those pages, the same way
+ * font characters are drawn from one texture.  Bitmaps are only packed
+ * together when they have the same transparency flags, since
+ * ogl_loadtexture converts a whole page with one set of flags.
+ */
+constexpr uint16_t ogl_hud_atlas_page_size{512};
+constexpr uint16_t ogl_hud_atlas_max_size{128};
+constexpr uint8_t ogl_hud_atlas_gap{2};	// transparent border so that filtering does not bleed between entries
+
+struct ogl_hud_atlas_page
+{
+	grs_main_bitmap bm;
+	uint8_t flags;
+	uint16_t x{}, y{}, row_h{};
+};
+
+static std::vector<std::unique_ptr<ogl_hud_atlas_page>> ogl_hud_atlas_pages;
+static std::unordered_map<const grs_bitmap *, grs_bitmap> ogl_hud_atlas_entries;
+
+static ogl_hud_atlas_page &ogl_hud_atlas_new_page(const uint8_t flags)
+{
+	auto &page = *ogl_hud_atlas_pages.emplace_back(std::make_unique<ogl_hud_atlas_page>());
+	page.flags = flags;
+	{
+		RAIIdmem<uint8_t[]> data;
+		const unsigned length{ogl_hud_atlas_page_size * ogl_hud_atlas_page_size};
+		MALLOC(data, uint8_t[], length);
+		std::fill_n(data.get(), length, TRANSPARENCY_COLOR);
+		gr_init_main_bitmap(page.bm, bm_mode::linear, 0, 0, ogl_hud_atlas_page_size, ogl_hud_atlas_page_size, ogl_hud_atlas_page_size, std::move(data));
+	}
+	page.bm.set_flags(flags);
+	ogl_init_texture(*(page.bm.gltexture = ogl_get_free_texture()), ogl_hud_atlas_page_size, ogl_hud_atlas_page_size, (flags & (BM_FLAG_TRANSPARENT | BM_FLAG_SUPER_TRANSPARENT)) ? OGL_FLAG_ALPHA : 0);
+	return page;
+}
+
+static void ogl_hud_atlas_add(grs_bitmap &bm)
+{
+	const uint16_t w = bm.bm_w, h = bm.bm_h;
+	if (!w || !h || w > ogl_hud_atlas_max_size || h > ogl_hud_atlas_max_size)
+		return;
+	if (ogl_hud_atlas_entries.contains(&bm))
+		return;
+	const uint8_t flags = bm.get_flag_mask(BM_FLAG_TRANSPARENT | BM_FLAG_SUPER_TRANSPARENT);
+	/* Shelf packing: only the newest page for each set of flags is
+	 * still open.
+	 */
+	const auto &&open_page = std::find_if(ogl_hud_atlas_pages.rbegin(), ogl_hud_atlas_pages.rend(), [flags](const std::unique_ptr<ogl_hud_atlas_page> &p) { return p->flags == flags; });
+	auto *page = (open_page == ogl_hud_atlas_pages.rend()) ? &ogl_hud_atlas_new_page(flags) : open_page->get();
+	if (page->x + w + ogl_hud_atlas_gap > ogl_hud_atlas_page_size)
+	{
+		page->y += page->row_h + ogl_hud_atlas_gap;
+		page->x = 0;
+		page->row_h = 0;
+	}
+	if (page->y + h + ogl_hud_atlas_gap > ogl_hud_atlas_page_size)
+		page = &ogl_hud_atlas_new_page(flags);
+	const auto src = rle_expand_texture(bm);
+	auto *const dst = page->bm.get_bitmap_data() + page->y * ogl_hud_atlas_page_size + page->x;
+	for (const unsigned row : xrange(h))
+		std::copy_n(src->get_bitmap_data() + row * src->bm_rowsize, w, dst + row * ogl_hud_atlas_page_size);
+	gr_init_sub_bitmap(ogl_hud_atlas_entries[&bm], page->bm, page->x, page->y, w, h);
+	page->x += w + ogl_hud_atlas_gap;
+	page->row_h = std::max(page->row_h, h);
+}
+
+}
+
+void ogl_free_hud_atlas()
+{
+	ogl_hud_atlas_entries.clear();
+	ogl_hud_atlas_pages.clear();
+}
+
+grs_bitmap &ogl_hud_atlas_bitmap(grs_bitmap &bm)
+{
+	if (ogl_hud_atlas_entries.empty())
+		return bm;
+	const auto i = ogl_hud_atlas_entries.find(&bm);
+	return i == ogl_hud_atlas_entries.end() ? bm : i->second;
+}
+
+}
+
+namespace dsx {
+
+namespace {
+
+static void ogl_build_hud_atlas()
+{
+	ogl_free_hud_atlas();
+	const auto add = [](const bitmap_index i) {
+		if (!GameBitmaps.valid_index(i))
+			return;
+		PIGGY_PAGE_IN(i);
+		ogl_hud_atlas_add(GameBitmaps[i]);
+	};
+	range_for (const auto i, Gauges)
+		add(i);
+#if DXX_BUILD_DESCENT == 2
+	range_for (const auto i, Gauges_hires)
+		add(i);
+#endif
+	for (auto &p : ogl_hud_atlas_pages)
+		ogl_loadbmtexture_f(p->bm, CGameCfg.TexFilt, 0, 0);
+	con_printf(CON_VERBOSE, "DXX-Rebirth: OpenGL: packed %zu HUD bitmaps into %zu atlas pages", ogl_hud_atlas_entries.size(), ogl_hud_atlas_pages.size());
+}
+
+}
+
 void ogl_cache_level_textures(void)
 {
 	auto &Effects = LevelUniqueEffectsClipState.Effects;
@@ -429,6 +895,7 @@ void ogl_cache_level_textures(void)
 	int max_efx{0},ef;
 	
 	ogl_reset_texture_stats_internal();//loading a new lev should reset textures
+	ogl_invalidate_level_geometry();
 	
 	range_for (auto &ec, partial_const_range(Effects, Num_effects))
 	{
@@ -557,6 +1024,8 @@ void ogl_cache_level_textures(void)
 			}
 		}
 	}
+	if (CGameArg.OglHudAtlas)
+		ogl_build_hud_atlas();
 	glmprintf((CON_DEBUG, "finished caching"));
 	r_cachedtexcount = r_texcount;
 }
@@ -1932,6 +2401,7 @@ static void ogl_freetexture(ogl_texture &gltexture)
 		r_texcount--;
 		glmprintf((CON_DEBUG, "ogl_freetexture(%p):%i (%i left)", &gltexture, gltexture.handle, r_texcount));
 		glDeleteTextures( 1, &gltexture.handle );
+		ogl_bound_texture = 0;
 //		gltexture->handle=0;
 		ogl_reset_texture(gltexture);
 	}
@@ -1974,14 +2444,19 @@ bool ogl_ubitmapm_cs(grs_canvas &canvas, int x, int y,int dw, int dh, grs_bitmap
 	return ogl_ubitmapm_cs(canvas, x, y, dw, dh, bm, color.init(c), true);
 }
 
-/*
- * Menu / gauges 
+namespace {
+
+struct ogl_bitmap_quad
+{
+	std::array<GLfloat, 8> vertices, texcoords;
+};
+
+/* Compute the screen position and texture coordinates used to draw `bm`
+ * onto `canvas`.  The texture of `bm` must already be loaded.
  */
-bool ogl_ubitmapm_cs(grs_canvas &canvas, const int entry_x, const int entry_y, const int entry_dw, const int entry_dh, grs_bitmap &bm, const ogl_colors::array_type &color_array)
+static ogl_bitmap_quad build_ogl_bitmap_quad(const grs_canvas &canvas, const int entry_x, const int entry_y, const int entry_dw, const int entry_dh, const grs_bitmap &bm)
 {
 	GLfloat u1,u2,v1,v2;
-	ogl_client_states<GLfloat, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY> cs;
-	auto &xo = std::get<0>(cs);
 	const int adjusted_canvas_x = entry_x + canvas.cv_bitmap.bm_x;
 	const int adjusted_canvas_y = entry_y + canvas.cv_bitmap.bm_y;
 
@@ -1996,15 +2471,11 @@ bool ogl_ubitmapm_cs(grs_canvas &canvas, const int entry_x, const int entry_y, c
 			? bm.bm_h
 			: entry_dh);
 
-	xo = adjusted_canvas_x / (static_cast<double>(last_width));
+	const GLfloat xo = adjusted_canvas_x / (static_cast<double>(last_width));
 	const GLfloat xf = (effective_dw + adjusted_canvas_x) / (static_cast<double>(last_width));
 	const GLfloat yo = 1.0 - adjusted_canvas_y / (static_cast<double>(last_height));
 	const GLfloat yf = 1.0 - (effective_dh + adjusted_canvas_y) / (static_cast<double>(last_height));
 
-	OGL_ENABLE(TEXTURE_2D);
-	ogl_bindbmtex(bm, 0);
-	ogl_texwrap(bm.gltexture,GL_CLAMP_TO_EDGE);
-	
 	if (bm.bm_x==0){
 		u1=0;
 		if (bm.bm_w==bm.gltexture->w)
@@ -2026,25 +2497,92 @@ bool ogl_ubitmapm_cs(grs_canvas &canvas, const int entry_x, const int entry_y, c
 		v2=(bm.bm_h+bm.bm_y)/static_cast<float>(bm.gltexture->th);
 	}
 
-	const std::array<GLfloat, 8> vertices{{
-		xo, yo,
-		xf, yo,
-		xf, yf,
-		xo, yf,
-	}};
-	const std::array<GLfloat, 8> texcoord_array{{
-		u1, v1,
-		u2, v1,
-		u2, v2,
-		u1, v2,
-	}};
-	glVertexPointer(2, GL_FLOAT, 0, vertices.data());
+	return {
+		.vertices{{
+			xo, yo,
+			xf, yo,
+			xf, yf,
+			xo, yf,
+		}},
+		.texcoords{{
+			u1, v1,
+			u2, v1,
+			u2, v2,
+			u1, v2,
+		}},
+	};
+}
+
+}
+
+/*
+ * Menu / gauges 
+ */
+bool ogl_ubitmapm_cs(grs_canvas &canvas, const int entry_x, const int entry_y, const int entry_dw, const int entry_dh, grs_bitmap &bm, const ogl_colors::array_type &color_array)
+{
+	ogl_client_states<int, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY> cs;
+	OGL_ENABLE(TEXTURE_2D);
+	ogl_bindbmtex(bm, 0);
+	ogl_texwrap(bm.gltexture,GL_CLAMP_TO_EDGE);
+
+	const auto quad{build_ogl_bitmap_quad(canvas, entry_x, entry_y, entry_dw, entry_dh, bm)};
+	glVertexPointer(2, GL_FLOAT, 0, quad.vertices.data());
 	glColorPointer(4, GL_FLOAT, 0, color_array.data());
-	glTexCoordPointer(2, GL_FLOAT, 0, texcoord_array.data());
+	glTexCoordPointer(2, GL_FLOAT, 0, quad.texcoords.data());
 	glDrawArrays(GL_TRIANGLE_FAN, 0, 4);//replaced GL_QUADS
 	return 0;
 }
 
+void ogl_bitmap_batch::add(grs_canvas &canvas, const int x, const int y, const int dw, const int dh, grs_bitmap &bm, const ogl_colors::array_type &color_array)
+{
+	if (run_bitmap && run_bitmap->gltexture != bm.gltexture)
+		flush();
+	else if (quads == max_quads)
+		flush();
+	if (!run_bitmap)
+	{
+		/* Load the texture now, so that build_ogl_bitmap_quad can read
+		 * its dimensions.  flush binds it again before drawing.
+		 */
+		if (bm.gltexture == nullptr || bm.gltexture->handle <= 0)
+			ogl_loadbmtexture(bm, 0);
+		run_bitmap = &bm;
+	}
+	const auto quad{build_ogl_bitmap_quad(canvas, x, y, dw, dh, bm)};
+	/* Split the quad into two triangles, so that all quads in the run
+	 * can be drawn with one call.
+	 */
+	constexpr std::array<uint8_t, vertices_per_quad> corners{{0, 1, 2, 0, 2, 3}};
+	const auto base{quads * vertices_per_quad};
+	for (const auto i : xrange(vertices_per_quad))
+	{
+		const unsigned corner{corners[i]};
+		const auto v{base + i};
+		vertices[v * 2] = quad.vertices[corner * 2];
+		vertices[v * 2 + 1] = quad.vertices[corner * 2 + 1];
+		texcoords[v * 2] = quad.texcoords[corner * 2];
+		texcoords[v * 2 + 1] = quad.texcoords[corner * 2 + 1];
+		std::copy_n(&color_array[corner * 4], 4, &colors[v * 4]);
+	}
+	++ quads;
+}
+
+void ogl_bitmap_batch::flush()
+{
+	if (!run_bitmap)
+		return;
+	ogl_client_states<int, GL_VERTEX_ARRAY, GL_COLOR_ARRAY, GL_TEXTURE_COORD_ARRAY> cs;
+	OGL_ENABLE(TEXTURE_2D);
+	ogl_bindbmtex(*run_bitmap, 0);
+	ogl_texwrap(run_bitmap->gltexture, GL_CLAMP_TO_EDGE);
+	glVertexPointer(2, GL_FLOAT, 0, vertices.data());
+	glColorPointer(4, GL_FLOAT, 0, colors.data());
+	glTexCoordPointer(2, GL_FLOAT, 0, texcoords.data());
+	glDrawArrays(GL_TRIANGLES, 0, quads * vertices_per_quad);
+	run_bitmap = nullptr;
+	quads = 0;
+}
+
 bool ogl_ubitmapm_cs(grs_canvas &canvas, int x0, int y0, int dw, int dh, grs_bitmap &bm, const ogl_colors::array_type &color_array, bool fill)
 {
 #if DXX_USE_STEREOSCOPIC_RENDER
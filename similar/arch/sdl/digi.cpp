@@ -74,6 +74,8 @@ struct sound_function_table_t
 	int  (*is_channel_playing)(sound_channel);
 	void (*stop_all_channels)();
 	void (*set_digi_volume)(int);
+	/* May be nullptr if the backend plays sounds without converting them. */
+	void (*preload_sounds)();
 };
 
 #if DXX_SOUND_TABLE_STYLE == DXX_STS_MIXER_WITH_POINTER
@@ -162,6 +164,7 @@ constexpr sound_function_table_t digi_mixer_table{
 	&digi_mixer_is_channel_playing,
 	&digi_mixer_stop_all_channels,
 	&digi_mixer_set_digi_volume,
+	&digi_mixer_preload_sounds,
 };
 #endif
 
@@ -176,6 +179,7 @@ constexpr sound_function_table_t digi_audio_table{
 	&digi_audio_is_channel_playing,
 	&digi_audio_stop_all_channels,
 	&digi_audio_set_digi_volume,
+	nullptr,
 };
 
 #if DXX_SOUND_TABLE_STYLE == DXX_STS_MIXER_WITH_POINTER
@@ -252,4 +256,10 @@ int  digi_is_channel_playing(const sound_channel channel)
 void digi_stop_all_channels() { fptr->stop_all_channels(); }
 void digi_set_digi_volume(int dvolume) { fptr->set_digi_volume(dvolume); }
 
+void digi_preload_sounds()
+{
+	if (const auto preload_sounds = fptr->preload_sounds)
+		preload_sounds();
+}
+
 }
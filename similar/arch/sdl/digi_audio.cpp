@@ -11,6 +11,9 @@
  *
  */
 
+#include <algorithm>
+#include <span>
+#include <vector>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -26,6 +29,7 @@
 #include "piggy.h"
 
 #include "compiler-range_for.h"
+#include "d_range.h"
 #include "d_sdl_audio.h"
 #include "d_underlying_value.h"
 
@@ -33,61 +37,6 @@ namespace dcx {
 
 namespace {
 
-/* This table is used to add two sound values together and pin
- * the value to avoid overflow.  (used with permission from ARDI)
- * DPH: Taken from SDL/src/SDL_mixer.c.
- */
-constexpr uint8_t mix8[] =
-{
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03,
-  0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
-  0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19,
-  0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24,
-  0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F,
-  0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A,
-  0x3B, 0x3C, 0x3D, 0x3E, 0x3F, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45,
-  0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x50,
-  0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x5B,
-  0x5C, 0x5D, 0x5E, 0x5F, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66,
-  0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, 0x70, 0x71,
-  0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x7B, 0x7C,
-  0x7D, 0x7E, 0x7F, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
-  0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x90, 0x91, 0x92,
-  0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0x9B, 0x9C, 0x9D,
-  0x9E, 0x9F, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0xA8,
-  0xA9, 0xAA, 0xAB, 0xAC, 0xAD, 0xAE, 0xAF, 0xB0, 0xB1, 0xB2, 0xB3,
-  0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xBB, 0xBC, 0xBD, 0xBE,
-  0xBF, 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9,
-  0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF, 0xD0, 0xD1, 0xD2, 0xD3, 0xD4,
-  0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xDB, 0xDC, 0xDD, 0xDE, 0xDF,
-  0xE0, 0xE1, 0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA,
-  0xEB, 0xEC, 0xED, 0xEE, 0xEF, 0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5,
-  0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-};
-
 static int digi_initialised = 0;
 
 struct sound_slot {
@@ -132,26 +81,69 @@ namespace dsx {
 
 namespace {
 
+/* Parameters of one playing slot, copied while the audio lock is held, so
+ * that mixing does not need the lock.
+ */
+struct sound_slot_mix
+{
+	std::span<const uint8_t> samples;
+	unsigned position;
+	bool looped;
+	fix vl, vr;
+};
+
+/* Add `samples`, scaled by `vl` and `vr`, to successive left/right pairs
+ * of `acc`.
+ */
+static void mix_sound_run(int32_t *const acc, const std::span<const uint8_t> samples, const fix vl, const fix vr)
+{
+	const auto n = samples.size();
+	const auto p = samples.data();
+	/* Written as a flat loop over plain arrays so that the compiler can
+	 * vectorize it.  Volumes are bounded in the snapshot, so the products
+	 * fit in 32 bits.  Division, unlike a right shift, truncates toward
+	 * zero as `fixmul` does, so negative samples are not biased down.
+	 */
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		const int32_t v = int32_t{p[i]} - 0x80;
+		acc[2 * i] += (v * vl) / 65536;
+		acc[2 * i + 1] += (v * vr) / 65536;
+	}
+}
+
+/* One entry per output byte of the buffer that SDL asks for.  This is sized
+ * when audio is opened, so that the callback never allocates.
+ */
+static std::vector<int32_t> Mix_accumulator;
+
 /* Audio mixing callback */
 //changed on 980905 by adb to cleanup, add pan support and optimize mixer
 static void audio_mixcallback(void *, Uint8 *stream, int len)
 {
-	Uint8 *streamend = stream + len;
 	if (!digi_initialised)
 		return;
 
-	memset(stream, 0x80, len); // fix "static" sound bug on Mac OS X
-
-	RAII_SDL_LockAudio lock_audio{};
-
-	range_for (auto &sl, SoundSlots)
+	/* SDL converts to the requested format, so `len` never exceeds the
+	 * buffer size it reported.  If it ever did, the excess is silent.
+	 */
+	const std::size_t frames = std::min<std::size_t>(len, Mix_accumulator.size()) / 2;
+	std::array<sound_slot_mix, std::size(SoundSlots)> active;
+	std::size_t nactive{0};
 	{
-		if (sl.playing) {
-			auto sldata = std::next(sl.samples.begin(), sl.position), slend = sl.samples.end();
-			Uint8 *sp = stream, s;
-			signed char v;
-			fix vl, vr;
+		RAII_SDL_LockAudio lock_audio{};
 
+		range_for (auto &sl, SoundSlots)
+		{
+			if (!sl.playing)
+				continue;
+			const std::size_t size = sl.samples.size();
+			if (!size)
+			{
+				sl.playing = 0;
+				continue;
+			}
+			fix vl, vr;
 			if (const auto x = static_cast<fix>(sl.pan); x & 0x8000) {
 				vl = 0x20000 - x * 2;
 				vr = 0x10000;
@@ -160,25 +152,54 @@ static void audio_mixcallback(void *, Uint8 *stream, int len)
 				vr = x * 2;
 			}
 			const auto sl_volume{sl.volume};
-			vl = fixmul(vl, sl_volume);
-			vr = fixmul(vr, sl_volume);
-			while (sp < streamend) {
-				if (sldata == slend) {
-					if (!sl.looped) {
-						sl.playing = 0;
-						break;
-					}
-					sldata = sl.samples.begin();
-				}
-				v = *(sldata++) - 0x80;
-				s = *sp;
-				*(sp++) = mix8[ s + fixmul(v, vl) + 0x80 ];
-				s = *sp;
-				*(sp++) = mix8[ s + fixmul(v, vr) + 0x80 ];
+			/* Any volume beyond this saturates the output even for the
+			 * quietest sample, and larger values could overflow the 32-bit
+			 * products in mix_sound_run.
+			 */
+			constexpr fix maximum_volume{0xffffff};
+			vl = std::clamp(fixmul(vl, sl_volume), -maximum_volume, maximum_volume);
+			vr = std::clamp(fixmul(vr, sl_volume), -maximum_volume, maximum_volume);
+			active[nactive++] = {sl.samples, sl.position, sl.looped, vl, vr};
+			/* Advance the slot now, so that the lock is not needed again
+			 * after mixing.
+			 */
+			const std::size_t end = sl.position + frames;
+			if (sl.looped)
+				sl.position = end % size;
+			else if (end >= size)
+			{
+				sl.playing = 0;
+				sl.position = size;
 			}
-			sl.position = std::distance(sl.samples.begin(), sldata);
+			else
+				sl.position = end;
+		}
+	}
+
+	/* Accumulate every slot at full precision and clamp once, rather than
+	 * saturating after each slot.
+	 */
+	const auto accumulator{std::span(Mix_accumulator).first(frames * 2)};
+	std::ranges::fill(accumulator, 0);
+	for (auto &m : std::span(active).first(nactive))
+	{
+		auto acc = accumulator.data();
+		auto position = m.position;
+		for (std::size_t remaining = frames; remaining;)
+		{
+			const auto run = m.samples.subspan(position).first(std::min<std::size_t>(remaining, m.samples.size() - position));
+			mix_sound_run(acc, run, m.vl, m.vr);
+			acc += 2 * run.size();
+			remaining -= run.size();
+			if (!m.looped)
+				break;
+			position = 0;
 		}
 	}
+	for (const std::size_t i : xrange(frames * 2))
+		stream[i] = std::clamp(accumulator[i] + 0x80, 0, UINT8_MAX);
+	/* Silence whatever is left: an odd trailing byte, or any excess. */
+	std::fill(stream + frames * 2, stream + len, 0x80);
 }
 
 }
@@ -214,6 +235,8 @@ int digi_audio_init()
 		return 1;
 		//end edit -MM
 	}
+	/* SDL_OpenAudio filled in the buffer size in bytes. */
+	Mix_accumulator.assign(WaveSpec.size, 0);
 	SDL_PauseAudio(0);
 
 	digi_initialised = 1;
@@ -43,6 +43,8 @@
 #include "d_underlying_value.h"
 #include "d_uspan.h"
 #include "d_zip.h"
+#include "digi_mixer_fir.h"
+#include "worker_pool.h"
 
 #define MIX_DIGI_DEBUG 0
 
@@ -206,115 +208,6 @@ static unique_span<uint8_t> convert_audio(const std::span<const uint8_t> input,
 #if DXX_FEATURE_INTERNAL_RESAMPLER_EMULATE_SOUNDBLASTER16
 namespace emulate_soundblaster16 {
 
-/*
- * Blackman windowed-sinc filter coefficients at 1/4 bandwidth of upsampled
- * frequency. Chosen for linear phase and approximates ~10th order IIR
- *
- * MATLAB/Octave code:
-
-	N = 51;   % Num coeffs (odd)
-	B = 0.25;  % 1/4 band
-	half = (N-1)/2;
-	n = (-half:half); % the sample index
-	% Windowed sinc
-	h_ideal = 2 * B .* sinc(B*n);
-	h_win = blackman(N);
-	b = h_win .* h_ideal.';
-	% Convert to fix point to ultimately apply to signed 16-bit data
-	b_s16 = int32(round(b * (2^16 -1)));  % coeffs!
-
- */
-constexpr std::size_t FILTER_LEN = 51;
-static constexpr std::array<int32_t, FILTER_LEN> coeffs_quarterband{{
-		0, 0, -7, -25, -35, 0, 94, 200, 205, 0, -395, -751, -702, 0, 1178, 2127,
-		1907, 0, -3050, -5490, -5011, 0, 9275, 20326, 29311, 32767, 29311,
-		20326, 9275, 0, -5011, -5490, -3050, 0, 1907, 2127, 1178, 0, -702,
-		-751, -395, 0, 205, 200, 94, 0, -35, -25, -7, 0, 0
-}}
-#if DXX_BUILD_DESCENT == 2
-,
-// Coefficient set for half-band (e.g. 22050 -> 44100)
-coeffs_halfband{{
-		0, 0, -11, 0, 49, 0, -133, 0, 290, 0, -558, 0, 992, 0, -1666, 0, 2697, 0,
-		-4313, 0, 7086, 0, -13117, 0, 41452, 65535, 41452, 0, -13117, 0, 7086, 0,
-		-4313, 0, 2697, 0, -1666, 0, 992, 0, -558, 0, 290, 0, -133, 0, 49, 0, -11,
-		0, 0
-}}
-#endif
-;
-
-// Fixed-point FIR filtering
-// Not optimal: consider optimization with 1/4, 1/2 band filters, and symmetric kernels
-static auto filter_fir(const unique_span<int8_t> signal_storage, const std::span<const int32_t, FILTER_LEN> coeffs)
-{
-	const auto signal{signal_storage.span()};
-	const std::size_t outsize = signal.size();
-	unique_span<int16_t> result(outsize);
-	const auto output{result.span()};
-	// A FIR filter is just a 1D convolution
-	// Keep only signalLen samples
-	for (const auto nn : xrange(outsize))
-	{
-		// Determine start/stop indices for convolved chunk
-		constexpr std::size_t coeffsLen = FILTER_LEN;
-		/* Avoid use of `std::max` here, since `nn + 1 < coeffsLen` would cause
-		 * unsigned subtraction to underflow.
-		 */
-		const std::size_t min_idx = (nn + 1 > coeffsLen ? nn + 1 - coeffsLen : 0u);
-		const std::size_t max_idx = nn;
-		if (min_idx > max_idx)
-			continue;
-
-		int32_t cur_output{0};  // Increase bit size for fixed point expansion
-		// Sum over each sample * coefficient in this column
-		for (const auto kk : xrange(min_idx, max_idx + 1))
-		{
-			const auto product = int32_t{signal[kk]} * coeffs[nn - kk];
-			cur_output = cur_output + product;
-		}
-
-		// Save and fit back into int16
-		output[nn] = static_cast<int16_t>(cur_output >> 8);  // Arithmetic shift
-	}
-	return result;
-}
-
-static auto upsample(const std::span<const uint8_t> input, const upscale_factor upFactor)
-{
-	const std::size_t factor = underlying_value(upFactor);
-	switch (upFactor)
-	{
-		case upscale_factor::from_11khz_to_44khz:
-#if DXX_BUILD_DESCENT == 2
-		case upscale_factor::from_22khz_to_44khz:
-#endif
-			break;
-		default:
-			cf_assert(false);
-	}
-	const auto upsampledLen = input.size() * factor;
-	/* Caution: `output` is sparsely initialized, so the value-initialization
-	 * from `make_unique` is necessary.  This site cannot be converted to
-	 * `make_unique_for_overwrite`.
-	 */
-	unique_span<int8_t> result(upsampledLen);
-	const auto output{result.span()};
-	using output_type = decltype(output)::value_type;
-	for (const auto ii : xrange(input.size()))
-	{
-		/* Assert that the minimum and maximum possible values in the input can
-		 * be represented in the output without truncation. */
-		using conversion_type = int16_t;
-		using input_type = decltype(input)::value_type;
-		constexpr int8_t convert_u8_to_s8{INT8_MIN};
-		static_assert(std::in_range<output_type>(conversion_type{input_type{0}} + convert_u8_to_s8));
-		static_assert(std::in_range<output_type>(conversion_type{input_type{UINT8_MAX}} + convert_u8_to_s8));
-		// Save input sample, convert to signed
-		output[ii*factor] = conversion_type{input[ii]} + convert_u8_to_s8;
-	}
-	return result;
-}
-
 static auto replicateChannel(const unique_span<int16_t> input_storage, const std::size_t output_per_input)
 {
 	const std::size_t chFactor = MIX_OUTPUT_CHANNELS;
@@ -337,18 +230,18 @@ static auto convert_audio(const std::span<const uint8_t> input, const std::size_
 	auto &coeffs =
 #if DXX_BUILD_DESCENT == 2
 		(upFactor == upscale_factor::from_22khz_to_44khz)
-		? coeffs_halfband
+		? soundblaster16_filter::coeffs_halfband
 		/* Otherwise, assume upscale_factor::from_11khz_to_44khz */
 		:
 #endif
-		coeffs_quarterband;
+		soundblaster16_filter::coeffs_quarterband;
 
-	return replicateChannel(
-	// First upsample
-	// Apply LPF filter to smooth out upscaled points
+	const std::size_t factor = underlying_value(upFactor);
+	unique_span<int16_t> filtered(input.size() * factor);
+	// Upsample, and apply LPF filter to smooth out upscaled points
 	// There will be some uniform amplitude loss here, but less than -3dB
-		filter_fir(upsample(input, upFactor), coeffs),
-		output_per_input);
+	soundblaster16_filter::upsample_filter(input, factor, coeffs, filtered.span());
+	return replicateChannel(std::move(filtered), output_per_input);
 }
 
 }
@@ -516,6 +409,31 @@ static Mix_Chunk &mixdigi_convert_sound(const sound_effect i)
 
 }
 
+/* Convert every loaded sound that has not been converted yet, so that the
+ * first use of a sound during play does not stall the game thread.  Each
+ * conversion only touches its own chunk, so the internal resamplers run on
+ * the worker pool.
+ */
+void digi_mixer_preload_sounds()
+{
+	if (!digi_initialised)
+		return;
+#if DXX_FEATURE_EXTERNAL_RESAMPLER_SDL_NATIVE
+	/* SDL conversion reports failures to the console, which must only be
+	 * used from the game thread.
+	 */
+	if (CGameArg.SndMixerMethod == digi_mixer_method::sdl_native)
+	{
+		for (const uint8_t i : xrange(MAX_SOUNDS))
+			mixdigi_convert_sound(sound_effect{i});
+		return;
+	}
+#endif
+	run_parallel(MAX_SOUNDS, [](void *, const std::size_t i) {
+		mixdigi_convert_sound(sound_effect{static_cast<uint8_t>(i)});
+	}, nullptr);
+}
+
 // Volume 0-F1_0
 sound_channel digi_mixer_start_sound(sound_effect soundnum, const fix volume, const sound_pan pan, const int looping, const int loop_start, const int loop_end, sound_object *)
 {
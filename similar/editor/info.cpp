@@ -244,7 +244,7 @@ static void info_display_default(grs_canvas &canvas, const grs_font &cv_font)
 	
 	{
 		const auto num_objects = LevelUniqueObjectState.num_objects;
-		gr_uprintf(canvas, cv_font, 0, 32, "Objs: %3d/%3" DXX_PRI_size_type, num_objects, MAX_OBJECTS.value);
+		gr_uprintf(canvas, cv_font, 0, 32, "Objs: %3d/%3u", num_objects, LevelUniqueObjectState.object_limit);
 	}
 
   	//--------------- Current_segment_number -------------
@@ -71,6 +71,8 @@ COPYRIGHT 1993-1998 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "screens.h"
 #include "texmap.h"
 #include "object.h"
+#include "ai.h"
+#include "fvi.h"
 #include "effects.h"
 #include "info.h"
 #include "console.h"
@@ -1037,6 +1039,9 @@ window_event_result editor_dialog::callback_handler(const d_event &event)
 	else if (event.type == event_type::window_close)
 	{
 		EditorWindow = NULL;
+		invalidate_segment_bounds();
+		invalidate_ai_path_heuristic();
+		invalidate_fvi_side_data();
 		close_editor();
 		return window_event_result::ignored;
 	}
@@ -81,6 +81,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "d_construct.h"
 #include "d_enumerate.h"
 #include "d_levelstate.h"
+#include "worker_pool.h"
 #include <utility>
 
 using std::min;
@@ -221,7 +222,6 @@ fix build_savegametime_from_gametime(const fix64 gametime, const fix64 t)
 
 }
 point_seg_array_t       Point_segs;
-point_seg_array_t::iterator       Point_segs_free_ptr;
 
 // ------ John: End of variables which must be saved as part of gamesave. -----
 
@@ -622,8 +622,6 @@ void init_ai_object(const d_robot_info_array &Robot_info, const vmobjptridx_t ob
 	}
 #endif
 
-	// This is astonishingly stupid!  This routine gets called by matcens! KILL KILL KILL!!! Point_segs_free_ptr = Point_segs;
-
 	obj.mtype.phys_info.velocity = {};
 	ailp->player_awareness_time = 0;
 	ailp->player_awareness_type = player_awareness_type_t::PA_NONE;
@@ -685,7 +683,7 @@ void init_ai_objects(const d_robot_info_array &Robot_info)
 	auto &Boss_teleport_segs = LevelSharedBossState.Teleport_segs;
 	auto &Objects = LevelUniqueObjectState.Objects;
 	auto &vmobjptridx = Objects.vmptridx;
-	Point_segs_free_ptr = Point_segs.begin();
+	ai_reset_all_paths();
 	Boss_gate_segs.clear();
 	Boss_teleport_segs.clear();
 
@@ -811,6 +809,271 @@ static void ai_turn_randomly(const vms_vector &vec_to_player, object_base &obj,
 }
 #endif
 
+namespace {
+
+/* Line of sight results from robots to the player, computed for the
+ * eligible robots at once, before the serial AI pass reaches them.  Each
+ * robot gets one ray ahead of time, from the point that do_ai_frame is
+ * expected to look from.  Any other point is traced when it is first
+ * queried, and kept for the rest of the frame.
+ *
+ * A stored result is only used if every input that
+ * player_is_visible_from_object would pass to find_vector_intersection
+ * still matches, and no wall has changed since the cache was built, so
+ * using the cache does not change robot behaviour.  The results do not
+ * depend on the number of worker threads.
+ */
+struct ai_perception_ray
+{
+	vms_vector origin;
+	vms_vector hit_pnt;
+	segnum_t object_segnum;
+	segnum_t startseg;
+	fvi_hit_type hit_type;
+	bool origin_is_object_center;
+};
+
+struct ai_perception_rays
+{
+	/* The object center, and up to two gun points. */
+	std::array<ai_perception_ray, 3> rays;
+	uint8_t count;
+};
+
+/* The parts of a wall that find_vector_intersection reads to decide
+ * whether a ray passes through it.
+ */
+struct ai_perception_wall_state
+{
+	uint8_t type;
+	wall_flags flags;
+	wall_state state;
+#if DXX_BUILD_DESCENT == 2
+	int8_t cloak_value;
+#endif
+	texture1_value tmap_num;
+	texture2_value tmap_num2;
+	bool operator==(const ai_perception_wall_state &) const = default;
+};
+
+struct ai_perception_cache
+{
+	bool valid;
+	fix64 game_time;
+	vms_vector target;
+	std::vector<ai_perception_wall_state> walls;
+	std::array<ai_perception_rays, MAX_OBJECTS> objects;
+};
+
+static ai_perception_cache Ai_perception_cache;
+
+/* With fewer robots than this, precomputing costs more than it saves. */
+constexpr std::size_t AI_PERCEPTION_MINIMUM_ROBOTS{8};
+
+static ai_perception_wall_state get_ai_perception_wall_state(fvcsegptr &vcsegptr, const wall &w)
+{
+	auto &uside = vcsegptr(w.segnum)->unique_segment::sides[w.sidenum];
+	return {
+		.type = w.type,
+		.flags = w.flags,
+		.state = w.state,
+#if DXX_BUILD_DESCENT == 2
+		.cloak_value = w.cloak_value,
+#endif
+		.tmap_num = uside.tmap_num,
+		.tmap_num2 = uside.tmap_num2,
+	};
+}
+
+static void build_ai_perception_walls(std::vector<ai_perception_wall_state> &walls)
+{
+	auto &vcsegptr = LevelSharedSegmentState.get_segments().vcptr;
+	walls.clear();
+	for (auto &w : LevelUniqueWallSubsystemState.Walls.vcptr)
+		walls.emplace_back(get_ai_perception_wall_state(vcsegptr, w));
+}
+
+/* Doors, blastable walls and triggers can change walls while
+ * object_move_all runs, after the cache was built.
+ */
+static bool ai_perception_walls_unchanged(const std::vector<ai_perception_wall_state> &walls)
+{
+	auto &vcsegptr = LevelSharedSegmentState.get_segments().vcptr;
+	auto &Walls = LevelUniqueWallSubsystemState.Walls;
+	if (walls.size() != Walls.get_count())
+		return false;
+	auto i = walls.begin();
+	for (auto &w : Walls.vcptr)
+		if (*i++ != get_ai_perception_wall_state(vcsegptr, w))
+			return false;
+	return true;
+}
+
+/* Guess the point that do_ai_frame will look from.  A wrong guess only
+ * costs the ray traced for it, since the point actually used is traced on
+ * first query.
+ */
+static vms_vector get_ai_perception_origin(const robot_info &robptr, const object &obj, const objnum_t objnum)
+{
+	auto &ailp = obj.ctype.ai_info.ail;
+	/* do_ai_frame counts down the fire timers before it checks them. */
+	if (!robptr.n_guns || robptr.attack_type || !ready_to_fire_any_weapon(robptr, ailp, FrameTime))
+		return obj.pos;
+#if DXX_BUILD_DESCENT == 1
+	(void)objnum;
+#elif DXX_BUILD_DESCENT == 2
+	if (!player_is_visible(ailp.previous_visibility) && ((objnum ^ d_tick_count) & 3))
+		return obj.pos;
+	if (!ready_to_fire_weapon1(ailp, FrameTime))
+		return calc_gun_point(robptr, obj, robot_gun_number::_0);
+#endif
+	return calc_gun_point(robptr, obj, obj.ctype.ai_info.CURRENT_GUN);
+}
+
+static bool build_ai_perception_ray(ai_perception_ray &ray, const vcobjptridx_t objp, const vms_vector &origin)
+{
+	auto &obj = *objp;
+	ray.origin = origin;
+	ray.object_segnum = obj.segnum;
+	ray.origin_is_object_center = (origin == obj.pos);
+	if (ray.origin_is_object_center)
+		ray.startseg = obj.segnum;
+	else
+	{
+		auto &Segments = LevelSharedSegmentState.get_segments();
+		const auto &&segnum{find_point_seg(LevelSharedSegmentState, origin, Segments.vcptridx(obj.segnum) DXX_lighting_hack_pass_parameter)};
+		/* The serial path moves the robot in this case, so leave it to
+		 * that path.
+		 */
+		if (segnum == segment_none)
+			return false;
+		ray.startseg = segnum;
+	}
+	return true;
+}
+
+/* Compute line of sight for every robot that will run AI after `first` in
+ * this frame.  The ray origins are found on the worker pool, and then all
+ * the rays are traced in one batch.  Each robot only writes its own entry,
+ * so the results are the same for any thread count.
+ */
+static void build_ai_perception(const d_robot_info_array &Robot_info, const objnum_t first)
+{
+	auto &Objects = LevelUniqueObjectState.Objects;
+	auto &cache = Ai_perception_cache;
+	cache.valid = true;
+	cache.game_time = GameTime64;
+	cache.target = ConsoleObject->pos;
+	build_ai_perception_walls(cache.walls);
+	static std::vector<objnum_t> candidates;
+	candidates.clear();
+	for (auto &r : cache.objects)
+		r.count = 0;
+	for (objnum_t i = first, end = Objects.get_count(); i < end; ++i)
+	{
+		auto &obj = *Objects.vcptr(i);
+		if (obj.type != object_type::OBJ_ROBOT || obj.control_source != object::control_type::ai || (obj.flags & OF_SHOULD_BE_DEAD))
+			continue;
+		if (obj.ctype.ai_info.SKIP_AI_COUNT)
+			continue;
+		if (vm_vec_dist_quick(obj.pos, cache.target) >= F1_0 * 200)
+			continue;
+		candidates.emplace_back(i);
+	}
+	if (candidates.size() < AI_PERCEPTION_MINIMUM_ROBOTS)
+		return;
+	run_parallel(candidates.size(), [&Robot_info, &Objects, &cache](const std::size_t k) {
+		const auto objnum{candidates[k]};
+		const auto &&objp{Objects.vcptridx(objnum)};
+		auto &r = cache.objects[objnum];
+		r.count = build_ai_perception_ray(r.rays[0], objp, get_ai_perception_origin(Robot_info[get_robot_id(objp)], objp, objnum));
+	});
+	static std::vector<fvi_batch_query> queries;
+	static std::vector<fvi_batch_result> results;
+	static std::vector<ai_perception_ray *> query_rays;
+	queries.clear();
+	query_rays.clear();
+	for (const auto objnum : candidates)
+	{
+		auto &r = cache.objects[objnum];
+		for (auto &ray : partial_range(r.rays, r.count))
+		{
+			queries.push_back({
+				fvi_query{
+					ray.origin,
+					cache.target,
+					fvi_query::unused_ignore_obj_list,
+					fvi_query::unused_LevelUniqueObjectState,
+					fvi_query::unused_Robot_info,
+					FQ_TRANSWALL,
+					Objects.vcptridx(objnum),
+				},
+				ray.startseg,
+				F1_0 / 4,
+			});
+			query_rays.emplace_back(&ray);
+		}
+	}
+	results.resize(queries.size());
+	find_vector_intersections(queries, results, fvi_batch_parallel::yes);
+	for (const auto i : xrange(queries.size()))
+	{
+		auto &ray = *query_rays[i];
+		ray.hit_type = results[i].hit_type;
+		ray.hit_pnt = results[i].hit_data.hit_pnt;
+	}
+}
+
+static bool ai_perception_cache_matches()
+{
+	auto &cache = Ai_perception_cache;
+	return cache.valid && cache.game_time == GameTime64 && cache.target == Believed_player_pos;
+}
+
+static const ai_perception_ray *find_ai_perception_ray(const vcobjptridx_t objp, const vms_vector &pos)
+{
+	auto &cache = Ai_perception_cache;
+	if (!ai_perception_cache_matches())
+		return nullptr;
+	auto &obj = *objp;
+	const bool origin_is_object_center{pos == obj.pos};
+	auto &r = cache.objects[objp.get_unchecked_index()];
+	for (auto &ray : partial_const_range(r.rays, r.count))
+		if (ray.origin == pos && ray.object_segnum == obj.segnum && ray.origin_is_object_center == origin_is_object_center)
+		{
+			if (!ai_perception_walls_unchanged(cache.walls))
+			{
+				cache.valid = false;
+				return nullptr;
+			}
+			return &ray;
+		}
+	return nullptr;
+}
+
+/* Keep a ray that player_is_visible_from_object traced itself, in case the
+ * same robot looks from the same point again this frame.
+ */
+static void store_ai_perception_ray(const vcobjptridx_t objp, const vms_vector &pos, const segnum_t startseg, const fvi_hit_type hit_type, const vms_vector &hit_pnt)
+{
+	if (!ai_perception_cache_matches())
+		return;
+	auto &r = Ai_perception_cache.objects[objp.get_unchecked_index()];
+	if (r.count >= r.rays.size())
+		return;
+	auto &obj = *objp;
+	r.rays[r.count++] = {
+		.origin = pos,
+		.hit_pnt = hit_pnt,
+		.object_segnum = obj.segnum,
+		.startseg = startseg,
+		.hit_type = hit_type,
+		.origin_is_object_center = (pos == obj.pos),
+	};
+}
+
+}
+
 //	Overall_agitation affects:
 //		Widens field of view.  Field of view is in range 0..1 (specified in bitmaps.tbl as N/360 degrees).
 //			Overall_agitation/128 subtracted from field of view, making robots see wider.
@@ -836,39 +1099,56 @@ player_visibility_state player_is_visible_from_object(const d_robot_info_array &
 		obj.ctype.ai_info.SUB_FLAGS &= ~SUB_FLAGS_GUNSEG;
 #endif
 
-	segnum_t startseg;
-	if (pos.x != obj.pos.x || pos.y != obj.pos.y || pos.z != obj.pos.z)
+	fvi_hit_type Hit_type;
+	if (const auto ray{find_ai_perception_ray(objp, pos)})
 	{
-		auto &Segments = LevelSharedSegmentState.get_segments();
-		const auto &&segnum{find_point_seg(LevelSharedSegmentState, pos, Segments.vcptridx(obj.segnum) DXX_lighting_hack_pass_parameter)};
-		if (segnum == segment_none) {
-			startseg = obj.segnum;
-			pos = obj.pos;
-			auto &robptr = Robot_info[get_robot_id(obj)];
-			move_towards_segment_center(robptr, LevelSharedSegmentState, obj);
-		} else
+#if DXX_BUILD_DESCENT == 2
+		if (ray->startseg != obj.segnum && obj.control_source == object::control_type::ai)
+			obj.ctype.ai_info.SUB_FLAGS |= SUB_FLAGS_GUNSEG;
+#endif
+		Hit_type = ray->hit_type;
+		Hit_pos = ray->hit_pnt;
+	}
+	else
+	{
+		segnum_t startseg;
+		bool cacheable{true};
+		if (pos.x != obj.pos.x || pos.y != obj.pos.y || pos.z != obj.pos.z)
 		{
+			auto &Segments = LevelSharedSegmentState.get_segments();
+			const auto &&segnum{find_point_seg(LevelSharedSegmentState, pos, Segments.vcptridx(obj.segnum) DXX_lighting_hack_pass_parameter)};
+			if (segnum == segment_none) {
+				cacheable = false;
+				startseg = obj.segnum;
+				pos = obj.pos;
+				auto &robptr = Robot_info[get_robot_id(obj)];
+				move_towards_segment_center(robptr, LevelSharedSegmentState, obj);
+			} else
+			{
 #if DXX_BUILD_DESCENT == 2
-			if (segnum != obj.segnum) {
-				if (obj.control_source == object::control_type::ai)
-					obj.ctype.ai_info.SUB_FLAGS |= SUB_FLAGS_GUNSEG;
-			}
+				if (segnum != obj.segnum) {
+					if (obj.control_source == object::control_type::ai)
+						obj.ctype.ai_info.SUB_FLAGS |= SUB_FLAGS_GUNSEG;
+				}
 #endif
-			startseg = segnum;
-		}
-	} else
-		startseg			= obj.segnum;
-	fvi_info Hit_data;
-	const auto Hit_type = find_vector_intersection(fvi_query{
-		pos,
-		Believed_player_pos,
-		fvi_query::unused_ignore_obj_list,
-		fvi_query::unused_LevelUniqueObjectState,
-		fvi_query::unused_Robot_info,
-		FQ_TRANSWALL, // -- Why were we checking objects? | FQ_CHECK_OBJS;		//what about trans walls???
-		objp,
-	}, startseg, F1_0 / 4, Hit_data);
-	Hit_pos = Hit_data.hit_pnt;
+				startseg = segnum;
+			}
+		} else
+			startseg			= obj.segnum;
+		fvi_info Hit_data;
+		Hit_type = find_vector_intersection(fvi_query{
+			pos,
+			Believed_player_pos,
+			fvi_query::unused_ignore_obj_list,
+			fvi_query::unused_LevelUniqueObjectState,
+			fvi_query::unused_Robot_info,
+			FQ_TRANSWALL, // -- Why were we checking objects? | FQ_CHECK_OBJS;		//what about trans walls???
+			objp,
+		}, startseg, F1_0 / 4, Hit_data);
+		Hit_pos = Hit_data.hit_pnt;
+		if (cacheable)
+			store_ai_perception_ray(objp, pos, startseg, Hit_type, Hit_pos);
+	}
 
 	if (Hit_type == fvi_hit_type::None)
 	{
@@ -1808,6 +2088,8 @@ static void compute_vis_and_vec(const d_robot_info_array &Robot_info, const vmob
 			}
 		} else {
 			//	Compute expensive stuff -- vec_to_player and player_visibility
+			if (!Ai_perception_cache.valid || Ai_perception_cache.game_time != GameTime64)
+				build_ai_perception(Robot_info, objp);
 			vm_vec_normalized_dir_quick(player_visibility.vec_to_player, Believed_player_pos, pos);
 			if (player_visibility.vec_to_player == vms_vector{})
 			{
@@ -3399,8 +3681,17 @@ void do_ai_frame(const d_level_shared_robot_info_state &LevelSharedRobotInfoStat
 				const object *min_obj{nullptr};
 				fix min_dist = F1_0*200, cur_dist;
 
-				for (auto &obj_search : vcobjptr)
+				/* vm_vec_dist_quick can report as little as 9/10 of the
+				 * true distance, so search a sphere large enough to hold
+				 * every robot which passes the test below.  Visit the
+				 * candidates in object number order, as a scan of every
+				 * object would, so that ties resolve the same way.
+				 */
+				nearby_object_buffer candidates;
+				find_objects_near(candidates, vcsegptridx(obj->segnum), obj->pos, vm_distance{F1_0 * 112}, nearby_object_order::objnum);
+				for (const auto &candidate : candidates)
 				{
+					auto &obj_search = *vcobjptr(candidate.objnum);
 					if (&obj_search != obj && obj_search.type == object_type::OBJ_ROBOT)
 					{
 						cur_dist = vm_vec_dist_quick(obj->pos, obj_search.pos);
@@ -4686,6 +4977,7 @@ void init_robots_for_level(void)
 	auto &BossUniqueState = LevelUniqueObjectState.BossState;
 	BossUniqueState.Boss_dying_start_time = 0;
 	Overall_agitation = 0;
+	Ai_perception_cache.valid = false;
 #if DXX_BUILD_DESCENT == 2
 	GameUniqueState.Final_boss_countdown_time = 0;
 	Ai_last_missile_camera = nullptr;
@@ -4862,7 +5154,7 @@ void ai_save_state(PHYSFS_File *fp)
 
 	{
 		int temp;
-		temp = Point_segs_free_ptr - Point_segs;
+		temp = ai_path_pool_high_water();
 		PHYSFSX_writeBytes(fp, &temp, sizeof(int));
 	}
 
@@ -5122,7 +5414,7 @@ int ai_restore_state(const d_robot_info_array &Robot_info, const NamedPHYSFS_Fil
 		temp = PHYSFSX_readSXE32(fp, swap);
 		if (temp > Point_segs.size())
 			throw std::out_of_range("too many points");
-		Point_segs_free_ptr = Point_segs.begin() + temp;
+		ai_path_pool_rebuild();
 	} else
 		ai_reset_all_paths();
 
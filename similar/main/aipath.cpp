@@ -23,7 +23,10 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
  *
  */
 
+#include <algorithm>
+#include <bitset>
 #include <numeric>
+#include <optional>
 #include <random>
 #include <stdio.h>		//	for printf()
 #include <stdlib.h>		// for d_rand() and qsort()
@@ -76,13 +79,136 @@ static void ai_path_set_orient_and_vel(const d_robot_info_array &Robot_info, obj
 								, player_visibility_state player_visibility, const vms_vector *vec_to_player
 #endif
 								);
-static void maybe_ai_path_garbage_collect(void);
-static void ai_path_garbage_collect(void);
 #if PATH_VALIDATION
 static void validate_all_paths();
 static int validate_path(int, point_seg* psegs, uint_fast32_t num_points);
 #endif
 
+/* Robot paths are stored in Point_segs, which is divided into fixed size
+ * slabs of one cache line each.  A path occupies a contiguous run of slabs
+ * owned by the object whose hide_index names the first slab of the run.
+ * Paths are built in Path_scratch and then copied into a run just large
+ * enough to hold them.  Releasing a path frees only its own run, so paths
+ * never need to be moved to reclaim space.
+ */
+constexpr std::size_t path_slab_points{4};
+constexpr std::size_t path_slab_count{MAX_POINT_SEGS / path_slab_points};
+static_assert(path_slab_count * path_slab_points == MAX_POINT_SEGS);
+
+struct path_slab_pool
+{
+	/* For the first slab of an allocated run, the object that owns the run
+	 * and the number of slabs in the run.  Unused for all other slabs.
+	 */
+	std::array<objnum_t, path_slab_count> owner;
+	std::array<uint16_t, path_slab_count> run_length;
+	std::bitset<path_slab_count> used;
+	path_slab_pool()
+	{
+		clear();
+	}
+	void clear()
+	{
+		owner.fill(object_none);
+		run_length.fill(0);
+		used.reset();
+	}
+	bool owns(objnum_t objnum, int hide_index) const;
+	std::optional<std::size_t> find_free_run(std::size_t slabs) const;
+	void allocate(objnum_t objnum, std::size_t first, std::size_t slabs);
+	void release(std::size_t first);
+	void release_abandoned(fvcobjptr &vcobjptr);
+};
+
+static path_slab_pool Path_pool;
+static point_seg_array_t Path_scratch;
+
+bool path_slab_pool::owns(const objnum_t objnum, const int hide_index) const
+{
+	if (hide_index < 0 || hide_index % path_slab_points)
+		return false;
+	const std::size_t first = hide_index / path_slab_points;
+	return first < path_slab_count && used[first] && owner[first] == objnum;
+}
+
+std::optional<std::size_t> path_slab_pool::find_free_run(const std::size_t slabs) const
+{
+	std::size_t run{0};
+	for (std::size_t i{0}; i != path_slab_count; ++i)
+	{
+		if (used[i])
+			run = 0;
+		else if (++run == slabs)
+			return i + 1 - slabs;
+	}
+	return std::nullopt;
+}
+
+void path_slab_pool::allocate(const objnum_t objnum, const std::size_t first, const std::size_t slabs)
+{
+	owner[first] = objnum;
+	run_length[first] = slabs;
+	for (const auto i : xrange(first, first + slabs))
+		used.set(i);
+}
+
+void path_slab_pool::release(const std::size_t first)
+{
+	for (const auto i : xrange(first, first + run_length[first]))
+		used.reset(i);
+	owner[first] = object_none;
+	run_length[first] = 0;
+}
+
+/* Free the runs of robots that died or started a new path without the old
+ * one being released.  Only needed when the pool has no room left.
+ */
+void path_slab_pool::release_abandoned(fvcobjptr &vcobjptr)
+{
+	for (const auto i : xrange(path_slab_count))
+	{
+		const auto objnum = owner[i];
+		if (objnum == object_none)
+			continue;
+		auto &obj = *vcobjptr(objnum);
+		if (obj.type != object_type::OBJ_ROBOT || obj.ctype.ai_info.hide_index != static_cast<int>(i * path_slab_points))
+			release(i);
+	}
+}
+
+//	Copy the first path_length points of Path_scratch into a new run owned by objp,
+//	releasing the run holding the previous path of objp.
+static void store_robot_path(const vmobjptridx_t objp, const unsigned path_length)
+{
+	auto &aip = objp->ctype.ai_info;
+	if (Path_pool.owns(objp, aip.hide_index))
+		Path_pool.release(aip.hide_index / path_slab_points);
+	aip.path_length = path_length;
+	if (!path_length)
+	{
+		aip.hide_index = -1;
+		return;
+	}
+	const std::size_t slabs = (path_length + path_slab_points - 1) / path_slab_points;
+	auto first = Path_pool.find_free_run(slabs);
+	if (!first)
+	{
+		Path_pool.release_abandoned(LevelUniqueObjectState.Objects.vcptr);
+		first = Path_pool.find_free_run(slabs);
+		if (!first)
+		{
+			//	Every slab belongs to a live robot.  Too bad for the robots.
+			ai_reset_all_paths();
+			first = Path_pool.find_free_run(slabs);
+		}
+	}
+	const auto hide_index = *first * path_slab_points;
+	Path_pool.allocate(objp, *first, slabs);
+	std::copy_n(Path_scratch.begin(), path_length, std::next(Point_segs.begin(), hide_index));
+	aip.hide_index = hide_index;
+	aip.path_length = path_length;
+}
+
 //	-----------------------------------------------------------------------------------------------------------
 //	Insert the point at the center of the side connecting two segments between the two points.
 // This is messy because we must insert into the list.  The simplest (and not too slow) way to do this is to start
@@ -259,6 +385,167 @@ static void move_towards_outside(const d_level_shared_segment_state &LevelShared
 }
 #endif
 
+/* Segment centers, and the greatest distance between the centers of any
+ * two connected segments.  A path of `n` segments can cover at most `n`
+ * times that distance, so (distance to goal / max step) never exceeds the
+ * number of segments still needed, which makes it a consistent heuristic
+ * for the A* search below.  Built on first use after a level is loaded.
+ * The editor can move vertices at any time, so the search is not used
+ * while the editor is open.
+ */
+static std::vector<vms_vector> Path_segment_centers;
+static fix Path_segment_max_step;
+
+static bool build_path_heuristic(const d_level_shared_segment_state &LevelSharedSegmentState)
+{
+#if DXX_USE_EDITOR
+	if (EditorWindow)
+		return false;
+#endif
+	auto &Segments = LevelSharedSegmentState.get_segments();
+	if (Path_segment_centers.size() == Segments.get_count())
+		return Path_segment_max_step > 0;
+	auto &vcvertptr = LevelSharedSegmentState.get_vertex_state().get_vertices().vcptr;
+	Path_segment_centers.clear();
+	Path_segment_centers.reserve(Segments.get_count());
+	for (auto &seg : Segments.vcptr)
+		Path_segment_centers.push_back(compute_segment_center(vcvertptr, seg));
+	fix max_step{0};
+	for (auto &&segp : Segments.vcptridx)
+		for (const auto child : segp->shared_segment::children)
+			if (IS_CHILD(child) && child > segp)
+				max_step = std::max<fix>(max_step, vm_vec_dist(Path_segment_centers[segp], Path_segment_centers[child]));
+	/* Leave a small margin so that rounding in vm_vec_dist cannot make the
+	 * heuristic overestimate.
+	 */
+	Path_segment_max_step = max_step ? max_step + 16 : 0;
+	return Path_segment_max_step > 0;
+}
+
+struct path_open_entry
+{
+	uint16_t f;
+	uint16_t g;
+	uint32_t sequence;
+	segnum_t segnum;
+	/* std::push_heap builds a max-heap, so "less" means "explore later":
+	 * larger estimated total first, then shallower, then inserted later.
+	 */
+	bool operator<(const path_open_entry &rhs) const
+	{
+		if (f != rhs.f)
+			return f > rhs.f;
+		if (g != rhs.g)
+			return g < rhs.g;
+		return sequence > rhs.sequence;
+	}
+};
+
+/* Storage for the A* search, reused across calls so that a search does
+ * not need to clear per-segment state.  An entry is only meaningful if its
+ * stamp matches the current search.
+ */
+struct path_search_arena
+{
+	uint32_t current_search;
+	std::array<uint32_t, MAX_SEGMENTS> discovered, expanded;
+	std::array<segnum_t, MAX_SEGMENTS> parent;
+	std::array<uint16_t, MAX_SEGMENTS> depth;
+	std::vector<path_open_entry> open;
+	uint32_t begin_search()
+	{
+		if (!++current_search)
+		{
+			discovered = {};
+			expanded = {};
+			current_search = 1;
+		}
+		open.clear();
+		return current_search;
+	}
+};
+
+static path_search_arena Path_search_arena;
+
+/* Find a path with the fewest segments from `start_seg` to `end_seg`, of
+ * at most `depth_limit` steps.  `passable_child` reports the segment
+ * reached through a side, or segment_none if the side cannot be used.
+ * `side_order` returns the order in which to try the sides of the next
+ * segment.  On success, write the path into `psegs`, start first, and
+ * return the number of points.  Return 0 if no path is found within the
+ * limit.
+ */
+template <typename passable_child_t, typename side_order_t>
+static unsigned create_path_points_astar(const d_level_shared_segment_state &LevelSharedSegmentState, const vcsegidx_t start_seg, const vcsegidx_t end_seg, const icsegidx_t blocked_seg, const unsigned depth_limit, passable_child_t &&passable_child, side_order_t &&side_order, const point_seg_array_t::iterator psegs)
+{
+	if (!build_path_heuristic(LevelSharedSegmentState))
+		return 0;
+	auto &Segments = LevelSharedSegmentState.get_segments();
+	auto &arena = Path_search_arena;
+	const auto search{arena.begin_search()};
+	const auto &goal_center{Path_segment_centers[end_seg]};
+	const auto heuristic{[&goal_center](const vcsegidx_t s) -> unsigned {
+		return static_cast<fix>(vm_vec_dist(Path_segment_centers[s], goal_center)) / Path_segment_max_step;
+	}};
+	if (heuristic(start_seg) > depth_limit)
+		return 0;
+	if (blocked_seg != segment_none)
+		arena.expanded[blocked_seg] = search;
+	uint32_t sequence{0};
+	arena.discovered[start_seg] = search;
+	arena.depth[start_seg] = 0;
+	arena.parent[start_seg] = segment_none;
+	arena.open.push_back({static_cast<uint16_t>(heuristic(start_seg)), 0, sequence++, start_seg});
+	while (!arena.open.empty())
+	{
+		std::pop_heap(arena.open.begin(), arena.open.end());
+		const auto entry{arena.open.back()};
+		arena.open.pop_back();
+		const segnum_t cur_seg{entry.segnum};
+		if (arena.expanded[cur_seg] == search || entry.g != arena.depth[cur_seg])
+			continue;
+		if (cur_seg == end_seg)
+		{
+			const unsigned num_points{arena.depth[cur_seg] + 1u};
+			auto p{psegs + num_points};
+			for (segnum_t s{cur_seg}; s != segment_none; s = arena.parent[s])
+			{
+				--p;
+				p->segnum = s;
+				p->point = Path_segment_centers[s];
+			}
+			return num_points;
+		}
+		arena.expanded[cur_seg] = search;
+		const unsigned next_depth{entry.g + 1u};
+		if (next_depth > depth_limit)
+			continue;
+		const cscusegment &&segp = Segments.vcptr(cur_seg);
+		for (const auto snum : side_order())
+		{
+			const auto this_seg{passable_child(cur_seg, segp, snum)};
+			if (this_seg == segment_none || arena.expanded[this_seg] == search)
+				continue;
+			if (arena.discovered[this_seg] == search && arena.depth[this_seg] <= next_depth)
+				continue;
+			const auto f{next_depth + heuristic(this_seg)};
+			if (f > depth_limit)
+				continue;
+			arena.discovered[this_seg] = search;
+			arena.depth[this_seg] = next_depth;
+			arena.parent[this_seg] = cur_seg;
+			arena.open.push_back({static_cast<uint16_t>(f), static_cast<uint16_t>(next_depth), sequence++, this_seg});
+			std::push_heap(arena.open.begin(), arena.open.end());
+		}
+	}
+	return 0;
+}
+
+}
+
+void invalidate_ai_path_heuristic()
+{
+	Path_segment_centers.clear();
 }
 
 //	-----------------------------------------------------------------------------------------------------------
@@ -339,6 +626,72 @@ std::pair<create_path_result, unsigned> create_path_points(const vmobjptridx_t o
 	);
 	std::uniform_int_distribution uid03(0, 3);
 #endif
+#if DXX_BUILD_DESCENT == 2
+	auto &player_info = get_local_plrobj().ctype.player_info;
+#endif
+	/* Return the segment reached by leaving `cur_seg` through side `snum`,
+	 * or segment_none if this object may not path through that side.
+	 */
+	const auto passable_child{[&](const segnum_t cur_seg, const cscusegment &segp, const sidenum_t snum) -> segnum_t {
+		if (!IS_CHILD(segp.s.children[snum]))
+			return segment_none;
+#if DXX_BUILD_DESCENT == 1
+#define AI_DOOR_OPENABLE_PLAYER_FLAGS
+#elif DXX_BUILD_DESCENT == 2
+#define AI_DOOR_OPENABLE_PLAYER_FLAGS	player_info.powerup_flags,
+#endif
+		if (!(WALL_IS_DOORWAY(GameBitmaps, Textures, vcwallptr, segp, snum) & WALL_IS_DOORWAY_FLAG::fly) && !ai_door_is_openable(obj, robptr, AI_DOOR_OPENABLE_PLAYER_FLAGS segp, snum))
+			return segment_none;
+#undef AI_DOOR_OPENABLE_PLAYER_FLAGS
+		const auto this_seg = segp.s.children[snum];
+#if DXX_BUILD_DESCENT == 2
+		Assert(this_seg != segment_none);
+		if (((cur_seg == avoid_seg) || (this_seg == avoid_seg)) && (ConsoleObject->segnum == avoid_seg)) {
+			const auto center_point{compute_center_point_on_side(vcvertptr, segp, snum)};
+			fvi_info		hit_data;
+
+			const auto hit_type = find_vector_intersection(fvi_query{
+				obj.pos,
+				center_point,
+				fvi_query::unused_ignore_obj_list,
+				fvi_query::unused_LevelUniqueObjectState,
+				fvi_query::unused_Robot_info,
+				0,
+				objp,
+			}, obj.segnum, obj.size, hit_data);
+			if (hit_type != fvi_hit_type::None)
+				return segment_none;
+		}
+#else
+		(void)cur_seg;
+#endif
+		return this_seg;
+	}};
+
+	/* Try a goal-directed search first.  It finds a path with the same
+	 * number of segments as the breadth-first search below, but usually
+	 * visits far fewer segments.  The breadth-first search may stop one
+	 * step short of `max_depth` when it reaches that depth elsewhere, so
+	 * only accept paths that are shorter than that.  If no such path
+	 * exists, fall through to the breadth-first search, which also
+	 * produces the partial path that callers expect when the goal is out
+	 * of reach.
+	 */
+	if (end_seg != segment_exit && end_seg != start_seg && max_depth > 2)
+	{
+		if (const auto n{create_path_points_astar(LevelSharedSegmentState, start_seg, end_seg, (avoid_seg != segment_none && start_seg != avoid_seg && end_seg != avoid_seg) ? avoid_seg : segment_none, max_depth - 2, passable_child, [&]() -> const per_side_array<sidenum_t> & {
+#if DXX_BUILD_DESCENT == 2
+			if (random_flag != create_path_random_flag::nonrandom && std::exchange(shuffle_random_flag, uid03(mrd)) == 0)
+				std::shuffle(side_traversal_translation.begin(), side_traversal_translation.end(), mrd);
+#endif
+			return side_traversal_translation;
+		}, psegs)})
+		{
+			l_num_points = n;
+			psegs += n;
+			goto cpp_path_found;
+		}
+	}
 	while (cur_seg != end_seg) {
 		const cscusegment &&segp = vcsegptr(cur_seg);
 #if DXX_BUILD_DESCENT == 2
@@ -366,54 +719,19 @@ std::pair<create_path_result, unsigned> create_path_points(const vmobjptridx_t o
 
 		for (const auto snum : side_traversal_translation)
 		{
-			if (!IS_CHILD(segp.s.children[snum]))
+			const auto this_seg{passable_child(cur_seg, segp, snum)};
+			if (this_seg == segment_none)
 				continue;
-#if DXX_BUILD_DESCENT == 1
-#define AI_DOOR_OPENABLE_PLAYER_FLAGS
-#elif DXX_BUILD_DESCENT == 2
-#define AI_DOOR_OPENABLE_PLAYER_FLAGS	player_info.powerup_flags,
-			auto &player_info = get_local_plrobj().ctype.player_info;
-#endif
-			if ((WALL_IS_DOORWAY(GameBitmaps, Textures, vcwallptr, segp, snum) & WALL_IS_DOORWAY_FLAG::fly) || ai_door_is_openable(obj, robptr, AI_DOOR_OPENABLE_PLAYER_FLAGS segp, snum))
-#undef AI_DOOR_OPENABLE_PLAYER_FLAGS
-			{
-				const auto this_seg = segp.s.children[snum];
-#if DXX_BUILD_DESCENT == 2
-				Assert(this_seg != segment_none);
-				if (((cur_seg == avoid_seg) || (this_seg == avoid_seg)) && (ConsoleObject->segnum == avoid_seg)) {
-					const auto center_point{compute_center_point_on_side(vcvertptr, segp, snum)};
-					fvi_info		hit_data;
-	
-					const auto hit_type = find_vector_intersection(fvi_query{
-						obj.pos,
-						center_point,
-						fvi_query::unused_ignore_obj_list,
-						fvi_query::unused_LevelUniqueObjectState,
-						fvi_query::unused_Robot_info,
-						0,
-						objp,
-					}, obj.segnum, obj.size, hit_data);
-					if (hit_type != fvi_hit_type::None)
-					{
-						goto dont_add;
-					}
-				}
-#endif
-
-				if (!visited[this_seg]) {
-					seg_queue[qtail].start = cur_seg;
-					seg_queue[qtail].end = this_seg;
-					visited[this_seg] = true;
-					depth[qtail++] = cur_depth+1;
-					if (depth[qtail-1] == max_depth) {
-						end_seg = seg_queue[qtail-1].end;
-						goto cpp_done1;
-					}	// end if (depth[...
-				}	// end if (!visited...
-			}	// if (WALL_IS_DOORWAY(...
-#if DXX_BUILD_DESCENT == 2
-dont_add: ;
-#endif
+			if (!visited[this_seg]) {
+				seg_queue[qtail].start = cur_seg;
+				seg_queue[qtail].end = this_seg;
+				visited[this_seg] = true;
+				depth[qtail++] = cur_depth+1;
+				if (depth[qtail-1] == max_depth) {
+					end_seg = seg_queue[qtail-1].end;
+					goto cpp_done1;
+				}	// end if (depth[...
+			}	// end if (!visited...
 		}
 
 		if (qtail <= 0)
@@ -486,6 +804,7 @@ cpp_done1: ;
 		*(original_psegs + i) = *(original_psegs + l_num_points - i - 1);
 		*(original_psegs + l_num_points - i - 1) = temp_point_seg;
 	}
+cpp_path_found: ;
 #if PATH_VALIDATION
 	validate_path(2, original_psegs, l_num_points);
 #endif
@@ -494,9 +813,8 @@ cpp_done1: ;
 	//	between the two points.  This is messy because we must insert into the list.  The simplest (and not too slow)
 	//	way to do this is to start at the end of the list and go backwards.
 	if (safety_flag != create_path_safety_flag::unsafe) {
-		if (psegs - Point_segs + l_num_points + 2 > MAX_POINT_SEGS) {
+		if (l_num_points * 2 > MAX_POINT_SEGS) {
 			//	Ouch!  Cannot insert center points in path.  So return unsafe path.
-			ai_reset_all_paths();
 			return std::make_pair(create_path_result::early, l_num_points);
 		} else {
 			l_num_points = insert_center_points(Segments, original_psegs, l_num_points);
@@ -652,7 +970,6 @@ void validate_all_paths(void)
 //	hide in Ai_local_info[objnum].goal_segment.
 //	Sets	objp->ctype.ai_info.hide_index,		a pointer into Point_segs, the first point_seg of the path.
 //			objp->ctype.ai_info.path_length,		length of path
-//			Point_segs_free_ptr				global pointer into Point_segs array
 void create_path_to_segment(const vmobjptridx_t objp, const robot_info &robptr, const unsigned max_length, const create_path_safety_flag safety_flag, const icsegidx_t goal_segment)
 {
 	auto &obj = *objp;
@@ -669,24 +986,17 @@ void create_path_to_segment(const vmobjptridx_t objp, const robot_info &robptr,
 	if (end_seg == segment_none) {
 		;
 	} else {
-		aip->path_length = create_path_points(objp, &robptr, start_seg, end_seg, Point_segs_free_ptr, max_length, create_path_random_flag::random, safety_flag, segment_none).second;
+		auto path_length = create_path_points(objp, &robptr, start_seg, end_seg, Path_scratch.begin(), max_length, create_path_random_flag::random, safety_flag, segment_none).second;
 #if DXX_BUILD_DESCENT == 2
-		aip->path_length = polish_path(objp, Point_segs_free_ptr, aip->path_length);
+		path_length = polish_path(objp, Path_scratch.begin(), path_length);
 #endif
-		aip->hide_index = Point_segs_free_ptr - Point_segs;
-		aip->cur_path_index = 0;
 #if DXX_BUILD_DESCENT == 1
 #ifndef NDEBUG
-		validate_path(6, Point_segs_free_ptr, aip->path_length);
+		validate_path(6, Path_scratch.begin(), path_length);
 #endif
 #endif
-		Point_segs_free_ptr += aip->path_length;
-		if (Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 > MAX_POINT_SEGS) {
-			//Int3();	//	Contact Mike: This is stupid.  Should call maybe_ai_garbage_collect before the add.
-			ai_reset_all_paths();
-			return;
-		}
-//		Assert(Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 < MAX_POINT_SEGS);
+		store_robot_path(objp, path_length);
+		aip->cur_path_index = 0;
 		aip->PATH_DIR = 1;		//	Initialize to moving forward.
 #if DXX_BUILD_DESCENT == 1
 		aip->SUBMODE = AISM_GOHIDE;		//	This forces immediate movement.
@@ -694,7 +1004,6 @@ void create_path_to_segment(const vmobjptridx_t objp, const robot_info &robptr,
 		ailp->mode = ai_mode::AIM_FOLLOW_PATH;
 		ailp->player_awareness_type = player_awareness_type_t::PA_NONE;		//	If robot too aware of player, will set mode to chase
 	}
-	maybe_ai_path_garbage_collect();
 }
 
 //	Change, 10/07/95: Used to create path to ConsoleObject->pos.  Now creates path to Believed_player_pos.
@@ -737,22 +1046,13 @@ void create_path_to_segment(const vmobjptridx_t objp, const robot_info &robptr,
 	if (end_seg == segment_none) {
 		;
 	} else {
-		aip->path_length = create_path_points(objp, &robptr, start_seg, end_seg, Point_segs_free_ptr, max_length, create_path_random_flag::random, safety_flag, segment_none).second;
-		aip->hide_index = Point_segs_free_ptr - Point_segs;
+		store_robot_path(objp, create_path_points(objp, &robptr, start_seg, end_seg, Path_scratch.begin(), max_length, create_path_random_flag::random, safety_flag, segment_none).second);
 		aip->cur_path_index = 0;
-		Point_segs_free_ptr += aip->path_length;
-		if (Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 > MAX_POINT_SEGS) {
-			ai_reset_all_paths();
-			return;
-		}
 
 		aip->PATH_DIR = 1;		//	Initialize to moving forward.
 		// -- UNUSED! aip->SUBMODE = AISM_GOHIDE;		//	This forces immediate movement.
 		ailp->player_awareness_type = player_awareness_type_t::PA_NONE;		//	If robot too aware of player, will set mode to chase
 	}
-
-	maybe_ai_path_garbage_collect();
-
 }
 #endif
 
@@ -761,7 +1061,6 @@ void create_path_to_segment(const vmobjptridx_t objp, const robot_info &robptr,
 //	hide in Ai_local_info[objnum].goal_segment
 //	Sets	objp->ctype.ai_info.hide_index,		a pointer into Point_segs, the first point_seg of the path.
 //			objp->ctype.ai_info.path_length,		length of path
-//			Point_segs_free_ptr				global pointer into Point_segs array
 void create_path_to_station(const vmobjptridx_t objp, const robot_info &robptr, int max_length)
 {
 	auto &obj = *objp;
@@ -780,33 +1079,22 @@ void create_path_to_station(const vmobjptridx_t objp, const robot_info &robptr,
 	if (end_seg == segment_none) {
 		;
 	} else {
-		aip->path_length = create_path_points(objp, &robptr, start_seg, end_seg, Point_segs_free_ptr, max_length, create_path_random_flag::random, create_path_safety_flag::safe, segment_none).second;
+		auto path_length = create_path_points(objp, &robptr, start_seg, end_seg, Path_scratch.begin(), max_length, create_path_random_flag::random, create_path_safety_flag::safe, segment_none).second;
 #if DXX_BUILD_DESCENT == 2
-		aip->path_length = polish_path(objp, Point_segs_free_ptr, aip->path_length);
+		path_length = polish_path(objp, Path_scratch.begin(), path_length);
 #endif
-		aip->hide_index = Point_segs_free_ptr - Point_segs;
-		aip->cur_path_index = 0;
 #if DXX_BUILD_DESCENT == 1
 #ifndef NDEBUG
-		validate_path(7, Point_segs_free_ptr, aip->path_length);
+		validate_path(7, Path_scratch.begin(), path_length);
 #endif
 #endif
-		Point_segs_free_ptr += aip->path_length;
-		if (Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 > MAX_POINT_SEGS) {
-			//Int3();	//	Contact Mike: Stupid.
-			ai_reset_all_paths();
-			return;
-		}
-//		Assert(Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 < MAX_POINT_SEGS);
+		store_robot_path(objp, path_length);
+		aip->cur_path_index = 0;
 		aip->PATH_DIR = 1;		//	Initialize to moving forward.
 		// aip->SUBMODE = AISM_GOHIDE;		//	This forces immediate movement.
 		ailp->mode = ai_mode::AIM_FOLLOW_PATH;
 		ailp->player_awareness_type = player_awareness_type_t::PA_NONE;
 	}
-
-
-	maybe_ai_path_garbage_collect();
-
 }
 
 
@@ -818,31 +1106,25 @@ void create_n_segment_path(const vmobjptridx_t objp, const robot_info &robptr, u
 	ai_static *const aip = &obj.ctype.ai_info;
 	ai_local *const ailp = &obj.ctype.ai_info.ail;
 
-	const auto &&cr0 = create_path_points(objp, &robptr, obj.segnum, segment_exit, Point_segs_free_ptr, path_length, create_path_random_flag::random, create_path_safety_flag::unsafe, avoid_seg);
-	aip->path_length = cr0.second;
+	const auto &&cr0 = create_path_points(objp, &robptr, obj.segnum, segment_exit, Path_scratch.begin(), path_length, create_path_random_flag::random, create_path_safety_flag::unsafe, avoid_seg);
+	auto num_points = cr0.second;
 	if (cr0.first == create_path_result::early)
 	{
-		Point_segs_free_ptr += aip->path_length;
 		for (;;)
 		{
-			const auto &&crf = create_path_points(objp, &robptr, obj.segnum, segment_exit, Point_segs_free_ptr, --path_length, create_path_random_flag::random, create_path_safety_flag::unsafe, segment_none);
-			aip->path_length = crf.second;
+			const auto &&crf = create_path_points(objp, &robptr, obj.segnum, segment_exit, Path_scratch.begin(), --path_length, create_path_random_flag::random, create_path_safety_flag::unsafe, segment_none);
+			num_points = crf.second;
 			if (crf.first != create_path_result::early)
 				break;
 		}
 		assert(path_length);
 	}
 
-	aip->hide_index = Point_segs_free_ptr - Point_segs;
-	aip->cur_path_index = 0;
 #if PATH_VALIDATION
-	validate_path(8, Point_segs_free_ptr, aip->path_length);
+	validate_path(8, Path_scratch.begin(), num_points);
 #endif
-	Point_segs_free_ptr += aip->path_length;
-	if (Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 > MAX_POINT_SEGS) {
-		//Int3();	//	Contact Mike: This is curious, though not deadly. /eip++;g
-		ai_reset_all_paths();
-	}
+	store_robot_path(objp, num_points);
+	aip->cur_path_index = 0;
 
 	aip->PATH_DIR = 1;		//	Initialize to moving forward.
 #if DXX_BUILD_DESCENT == 1
@@ -862,9 +1144,6 @@ void create_n_segment_path(const vmobjptridx_t objp, const robot_info &robptr, u
 		}
 	}
 #endif
-
-	maybe_ai_path_garbage_collect();
-
 }
 
 //	-------------------------------------------------------------------------------------------------------
@@ -910,7 +1189,6 @@ void create_n_segment_path_to_door(const vmobjptridx_t objp, const robot_info &r
 //	hide in Ai_local_info[objnum].goal_segment.
 //	Sets	objp->ctype.ai_info.hide_index,		a pointer into Point_segs, the first point_seg of the path.
 //			objp->ctype.ai_info.path_length,		length of path
-//			Point_segs_free_ptr				global pointer into Point_segs array
 #if DXX_BUILD_DESCENT == 1
 namespace {
 
@@ -928,22 +1206,15 @@ static void create_path(const vmobjptridx_t objp, const robot_info &robptr)
 	if (end_seg == segment_none) {
 		;
 	} else {
-		aip->path_length = create_path_points(objp, &robptr, start_seg, end_seg, Point_segs_free_ptr, MAX_PATH_LENGTH, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none).second;
-		aip->hide_index = Point_segs_free_ptr - Point_segs;
-		aip->cur_path_index = 0;
+		const auto path_length = create_path_points(objp, &robptr, start_seg, end_seg, Path_scratch.begin(), MAX_PATH_LENGTH, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none).second;
 #ifndef NDEBUG
-		validate_path(5, Point_segs_free_ptr, aip->path_length);
+		validate_path(5, Path_scratch.begin(), path_length);
 #endif
-		Point_segs_free_ptr += aip->path_length;
-		if (Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 > MAX_POINT_SEGS) {
-			//Int3();	//	Contact Mike: This is curious, though not deadly. /eip++;g
-			ai_reset_all_paths();
-		}
+		store_robot_path(objp, path_length);
+		aip->cur_path_index = 0;
 		aip->PATH_DIR = 1;		//	Initialize to moving forward.
 		aip->SUBMODE = AISM_HIDING;		//	Pretend we are hiding, so we sit here until bothered.
 	}
-
-	maybe_ai_path_garbage_collect();
 }
 }
 #endif
@@ -964,6 +1235,15 @@ void ai_follow_path(const d_robot_info_array &Robot_info, const vmobjptridx_t ob
 	int			forced_break, original_dir, original_index;
 	ai_local *const ailp = &obj.ctype.ai_info.ail;
 
+	if (aip->path_length > 0 && !Path_pool.owns(objp, aip->hide_index))
+	{
+		//	The path was not created by this robot, for example because control of
+		//	the robot passed to this system in a multiplayer game.  Its points may
+		//	belong to some other robot, so drop it.
+		aip->hide_index = -1;
+		aip->path_length = 0;
+	}
+
 	if ((aip->hide_index == -1) || (aip->path_length == 0))
 	{
 		if (ailp->mode == ai_mode::AIM_RUN_FROM_OBJECT) {
@@ -980,16 +1260,6 @@ void ai_follow_path(const d_robot_info_array &Robot_info, const vmobjptridx_t ob
 		}
 	}
 
-	if ((aip->hide_index + aip->path_length > Point_segs_free_ptr - Point_segs) && (aip->path_length>0)) {
-#if DXX_BUILD_DESCENT == 2
-		Int3();	//	Contact Mike: Bad.  Path goes into what is believed to be free space.
-		//	This is debugging code.  Figure out why garbage collection
-		//	didn't compress this object's path information.
-		ai_path_garbage_collect();
-#endif
-		ai_reset_all_paths();
-	}
-
 	if (aip->path_length < 2) {
 #if DXX_BUILD_DESCENT == 1
 		if (ailp->mode == ai_mode::AIM_RUN_FROM_OBJECT)
@@ -1243,17 +1513,6 @@ void ai_follow_path(const d_robot_info_array &Robot_info, const vmobjptridx_t ob
 
 }
 
-namespace {
-
-int	Last_tick_garbage_collected;
-
-struct obj_path {
-	short	path_start;
-	objnum_t objnum;
-};
-
-}
-
 namespace dsx {
 namespace {
 
@@ -1339,119 +1598,72 @@ void ai_path_set_orient_and_vel(const d_robot_info_array &Robot_info, object &ob
 	ai_turn_towards_vector(norm_vec_to_goal, objp, rate);
 }
 
-//	----------------------------------------------------------------------------------------------------------
-//	Garbage colledion -- Free all unused records in Point_segs and compress all paths.
-void ai_path_garbage_collect()
-{
-	int free_path_index{0};
-	int num_path_objects{0};
-	int	objind;
-	std::array<obj_path, MAX_OBJECTS>		object_list;
+}
 
+//	-----------------------------------------------------------------------------
+//	Reset all paths.  Free every slab in the path pool.
+//	Should be called at the start of each level.
+void ai_reset_all_paths(void)
+{
 	auto &Objects = LevelUniqueObjectState.Objects;
-	auto &vcobjptridx = Objects.vcptridx;
-	auto &vmobjptridx = Objects.vmptridx;
-
-	Last_tick_garbage_collected = d_tick_count;
-
-#if PATH_VALIDATION
-	validate_all_paths();
-#endif
-	//	Create a list of objects which have paths of length 1 or more.
-	range_for (const auto &&objp, vcobjptridx)
-	{
-		if (objp->type == object_type::OBJ_ROBOT && (objp->control_source == object::control_type::ai
-#if DXX_BUILD_DESCENT == 2
-			|| objp->control_source == object::control_type::morph
-#endif
-										  )) {
-			const auto &aip = objp->ctype.ai_info;
-			if (aip.path_length) {
-				auto &ol{object_list[num_path_objects]};
-				++ num_path_objects;
-				ol.path_start = aip.hide_index;
-				ol.objnum = objp;
-			}
-		}
-	}
-	std::ranges::sort(std::span(object_list).first(num_path_objects), {}, &obj_path::path_start);
-
-	for (objind=0; objind < num_path_objects; objind++) {
-		ai_static	*aip;
-		int			i;
-		int			old_index;
-
-		auto objnum = object_list[objind].objnum;
-		object &objp = vmobjptridx(objnum);
-		aip = &objp.ctype.ai_info;
-		old_index = aip->hide_index;
-
-		aip->hide_index = free_path_index;
-		for (i=0; i<aip->path_length; i++)
-			Point_segs[free_path_index++] = Point_segs[old_index++];
-	}
-
-	Point_segs_free_ptr = Point_segs.begin() + free_path_index;
-
-#ifndef NDEBUG
-	{
-	auto &vcobjptr = Objects.vcptr;
-	for (auto &obj : vcobjptr)
+	auto &vmobjptr = Objects.vmptr;
+	for (auto &obj : vmobjptr)
 	{
-		const auto &aip = obj.ctype.ai_info;
-
 		if (obj.type == object_type::OBJ_ROBOT && obj.control_source == object::control_type::ai)
-			if ((aip.hide_index + aip.path_length > Point_segs_free_ptr - Point_segs) && (aip.path_length>0))
-				Int3();		//	Contact Mike: Debug trap for nasty, elusive bug.
+		{
+			obj.ctype.ai_info.hide_index = -1;
+			obj.ctype.ai_info.path_length = 0;
+		}
 	}
 
-	validate_all_paths();
-	}
-#endif
+	Path_pool.clear();
 }
 
 //	-----------------------------------------------------------------------------
-//	Do garbage collection if not been done for awhile, or things getting really critical.
-void maybe_ai_path_garbage_collect(void)
+//	Release the path owned by objp, if any.  Called when a robot is deleted.
+void ai_path_free(const vmobjptridx_t objp)
 {
-	if (Point_segs_free_ptr - Point_segs > MAX_POINT_SEGS - MAX_PATH_LENGTH) {
-		if (Last_tick_garbage_collected+1 >= d_tick_count) {
-			//	This is kind of bad.  Garbage collected last frame or this frame.
-			//	Just destroy all paths.  Too bad for the robots.  They are memory wasteful.
-			ai_reset_all_paths();
-		} else {
-			//	We are really close to full, but didn't just garbage collect, so maybe this is recoverable.
-			ai_path_garbage_collect();
-		}
-	} else if (Point_segs_free_ptr - Point_segs > 3*MAX_POINT_SEGS/4) {
-		if (Last_tick_garbage_collected + 16 < d_tick_count) {
-			ai_path_garbage_collect();
-		}
-	} else if (Point_segs_free_ptr - Point_segs > MAX_POINT_SEGS/2) {
-		if (Last_tick_garbage_collected + 256 < d_tick_count) {
-			ai_path_garbage_collect();
-		}
-	}
+	auto &aip = objp->ctype.ai_info;
+	if (Path_pool.owns(objp, aip.hide_index))
+		Path_pool.release(aip.hide_index / path_slab_points);
+	aip.hide_index = -1;
+	aip.path_length = 0;
 }
+
+//	-----------------------------------------------------------------------------
+//	Return one past the last point in use, for savegames that expect a bump pointer.
+unsigned ai_path_pool_high_water()
+{
+	for (std::size_t i{path_slab_count}; i--;)
+		if (Path_pool.used[i])
+			return (i + 1) * path_slab_points;
+	return 0;
 }
 
 //	-----------------------------------------------------------------------------
-//	Reset all paths.  Do garbage collection.
-//	Should be called at the start of each level.
-void ai_reset_all_paths(void)
+//	Rebuild the path pool from the paths named by each robot after Point_segs
+//	was read from a savegame.  Older savegames placed paths without regard to
+//	slab boundaries, so each path is copied into a run of its own.
+void ai_path_pool_rebuild()
 {
 	auto &Objects = LevelUniqueObjectState.Objects;
-	auto &vmobjptr = Objects.vmptr;
-	for (auto &obj : vmobjptr)
+	auto &vmobjptridx = Objects.vmptridx;
+	const point_seg_array_t saved_segs = Point_segs;
+	Path_pool.clear();
+	for (const auto &&objp : vmobjptridx)
 	{
-		if (obj.type == object_type::OBJ_ROBOT && obj.control_source == object::control_type::ai)
-		{
-			obj.ctype.ai_info.hide_index = -1;
-			obj.ctype.ai_info.path_length = 0;
-		}
+		if (objp->type != object_type::OBJ_ROBOT)
+			continue;
+		auto &aip = objp->ctype.ai_info;
+		const auto hide_index = aip.hide_index;
+		const auto path_length = aip.path_length;
+		aip.hide_index = -1;
+		aip.path_length = 0;
+		if (hide_index < 0 || path_length <= 0 || static_cast<unsigned>(hide_index + path_length) > MAX_POINT_SEGS)
+			continue;
+		std::copy_n(std::next(saved_segs.begin(), hide_index), path_length, Path_scratch.begin());
+		store_robot_path(objp, path_length);
 	}
-
-	ai_path_garbage_collect();
 }
 
 //	---------------------------------------------------------------------------------------------------------
@@ -1521,7 +1733,7 @@ static void test_create_path(fvmobjptridx &vmobjptridx)
 dxx_compiler_attribute_used
 static void test_create_all_paths(fvmobjptridx &vmobjptridx, fvcsegptridx &vcsegptridx)
 {
-	Point_segs_free_ptr = Point_segs.begin();
+	std::array<point_seg, 200> point_segs;
 
 	range_for (const auto &&segp0, vcsegptridx)
 	{
@@ -1533,13 +1745,15 @@ static void test_create_all_paths(fvmobjptridx &vmobjptridx, fvcsegptridx &vcseg
 				const shared_segment &sseg1 = segp1;
 				if (sseg1.segnum != segment_none)
 				{
-					create_path_points(vmobjptridx(object_first), create_path_unused_robot_info, segp0, segp1, Point_segs_free_ptr, MAX_PATH_LENGTH, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none);
+					create_path_points(vmobjptridx(object_first), create_path_unused_robot_info, segp0, segp1, point_segs.begin(), MAX_PATH_LENGTH, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none);
 				}
 			}
 		}
 	}
 }
 
+//	The player's path is kept apart from the robot path pool.
+std::array<point_seg, 200> Player_path_segs;
 short Player_path_length{0};
 int	Player_hide_index=-1;
 int Player_cur_path_index{0};
@@ -1606,8 +1820,8 @@ void player_follow_path(object &objp)
 	if (Player_path_length < 2)
 		return;
 
-	goal_point = Point_segs[Player_hide_index + Player_cur_path_index].point;
-	goal_seg = Point_segs[Player_hide_index + Player_cur_path_index].segnum;
+	goal_point = Player_path_segs[Player_hide_index + Player_cur_path_index].point;
+	goal_seg = Player_path_segs[Player_hide_index + Player_cur_path_index].segnum;
 	Assert((goal_seg >= 0) && (goal_seg <= Highest_segment_index));
 	(void)goal_seg;
 	auto dist_to_goal = vm_vec_dist_quick(goal_point, objp.pos);
@@ -1617,7 +1831,7 @@ void player_follow_path(object &objp)
 	else if (Player_cur_path_index >= Player_path_length)
 		Player_cur_path_index = Player_path_length-1;
 
-	goal_point = Point_segs[Player_hide_index + Player_cur_path_index].point;
+	goal_point = Player_path_segs[Player_hide_index + Player_cur_path_index].point;
 
 	count=0;
 
@@ -1649,7 +1863,7 @@ void player_follow_path(object &objp)
 			forced_break = 1;
 		}
 
-		goal_point = Point_segs[Player_hide_index + Player_cur_path_index].point;
+		goal_point = Player_path_segs[Player_hide_index + Player_cur_path_index].point;
 		dist_to_goal = vm_vec_dist_quick(goal_point, objp.pos);
 
 	}	//	end while
@@ -1669,21 +1883,15 @@ static void create_player_path_to_segment(fvmobjptridx &vmobjptridx, segnum_t se
 	Player_cur_path_index=0;
 	Player_following_path_flag=0;
 
-	auto &&cr = create_path_points(objp, create_path_unused_robot_info, objp->segnum, segnum, Point_segs_free_ptr, 100, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none);
+	auto &&cr = create_path_points(objp, create_path_unused_robot_info, objp->segnum, segnum, Player_path_segs.begin(), 100, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none);
 	Player_path_length = cr.second;
 	if (cr.first == create_path_result::early)
 		con_printf(CON_DEBUG,"Unable to form path of length %i for myself", 100);
 
 	Player_following_path_flag = 1;
 
-	Player_hide_index = Point_segs_free_ptr - Point_segs;
+	Player_hide_index = 0;
 	Player_cur_path_index = 0;
-	Point_segs_free_ptr += Player_path_length;
-	if (Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 > MAX_POINT_SEGS) {
-		//Int3();	//	Contact Mike: This is curious, though not deadly. /eip++;g
-		ai_reset_all_paths();
-	}
-
 }
 
 }
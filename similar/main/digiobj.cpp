@@ -44,6 +44,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "config.h"
 
 #include "compiler-range_for.h"
+#include "d_enumerate.h"
 #include "d_levelstate.h"
 #include <iterator>
 #include <utility>
@@ -62,6 +63,17 @@ constexpr std::integral_constant<unsigned, 32> SOF_PERMANENT{};		// Part of the
 
 constexpr std::integral_constant<unsigned, 150> MAX_SOUND_OBJECTS{};
 
+/* Each frame, digi_sync_sounds recomputes this many sound objects even if
+ * nothing moved, so that changes it cannot track, such as doors opening,
+ * are picked up within MAX_SOUND_OBJECTS / sound_refresh_budget frames.
+ * Inaudible sounds that may have come in range are only recomputed in
+ * their turn.
+ */
+constexpr std::integral_constant<unsigned, 16> sound_refresh_budget{};
+
+/* Movement smaller than this does not make a sound's location stale. */
+constexpr vm_distance sound_refresh_epsilon{F1_0 / 16};
+
 }
 
 sound_channel SoundQ_channel;
@@ -94,6 +106,16 @@ struct sound_object
 			object_signature_t			objsignature;
 		} obj;
 	} link_type;
+	/* Inputs of the last digi_update_sound_loc, used by digi_sync_sounds
+	 * to skip sounds whose volume and pan cannot have changed.
+	 */
+	struct location_cache {
+		vms_vector listener_rvec, listener_uvec, listener_pos, sound_pos;
+		segnum_t listener_segnum, sound_segnum;
+		// If out of range, how far the listener and sound can move before it could be in range
+		vm_distance silent_distance;
+		bool valid;
+	} location;
 };
 
 namespace {
@@ -226,6 +248,57 @@ static void digi_update_sound_loc(const vms_matrix &listener, const vms_vector &
 	auto &&[volume, pan] = digi_get_sound_loc(listener, listener_pos, listener_seg, sound_pos, sound_seg, so.max_volume, so.max_distance);
 	so.volume = volume;
 	so.pan = pan;
+	auto &c = so.location;
+	c.listener_rvec = listener.rvec;
+	c.listener_uvec = listener.uvec;
+	c.listener_pos = listener_pos;
+	c.sound_pos = sound_pos;
+	c.listener_segnum = listener_seg;
+	c.sound_segnum = sound_seg;
+	c.valid = true;
+	c.silent_distance = {};
+	if (volume > 0)
+		return;
+	/* digi_get_sound_loc rejects any sound whose quick distance is at
+	 * least 1.25 * max_distance, regardless of walls.  The quick distance
+	 * is within 0.90x - 1.09x of the true distance, so the sound stays out
+	 * of range as long as the quick movement of both ends sums to less
+	 * than 33/40 of the current quick distance, less the range.
+	 */
+	const fix64 d{static_cast<fix>(vm_vec_dist_quick(sound_pos, listener_pos))};
+	const fix64 range{(fix64{static_cast<fix>(so.max_distance)} * 5) / 4};
+	if (const auto slack = (d * 33) / 40 - range; slack > 0)
+		c.silent_distance = vm_distance{static_cast<fix>(std::min<fix64>(slack, INT32_MAX))};
+}
+
+/* Return true if the volume or pan of `so` may differ from its last
+ * update.  `due` is set when it is this sound's turn to be recomputed
+ * regardless of what moved.
+ */
+static bool digi_sound_loc_stale(const sound_object &so, const object_base &viewer, const vms_vector &sound_pos, const segnum_t sound_segnum, const bool due)
+{
+	auto &c = so.location;
+	if (!c.valid)
+		return true;
+	const auto moved{vm_vec_dist_quick(viewer.pos, c.listener_pos) + vm_vec_dist_quick(sound_pos, c.sound_pos)};
+	if (so.volume < 1)
+	{
+		/* Still too far away to be heard, even if doors open. */
+		if (moved < c.silent_distance)
+			return false;
+		/* Other inaudible sounds are only recomputed in their turn, so
+		 * that a level full of distant ambient sounds does not search
+		 * paths for all of them whenever the player moves.
+		 */
+		return due;
+	}
+	if (due)
+		return true;
+	return sound_refresh_epsilon < moved ||
+		viewer.segnum != c.listener_segnum ||
+		sound_segnum != c.sound_segnum ||
+		viewer.orient.rvec != c.listener_rvec ||
+		viewer.orient.uvec != c.listener_uvec;
 }
 
 }
@@ -407,6 +480,7 @@ static void digi_link_sound_common(const object_base &viewer, sound_object &so,
 	so.max_distance = max_distance;
 	so.volume = 0;
 	so.pan = {};
+	so.location.valid = false;
 	if (Dont_start_sound_objects) {		//started at level start
 		so.flags |= SOF_PERMANENT;
 		so.channel = sound_channel::None;
@@ -569,6 +643,7 @@ static void digi_record_sound_objects()
 }
 
 static int was_recording = 0;
+static unsigned sound_refresh_cursor;
 
 }
 
@@ -591,10 +666,13 @@ void digi_sync_sounds()
 	auto &Objects = LevelUniqueObjectState.Objects;
 	auto &vcobjptr = Objects.vcptr;
 	const auto viewer{Viewer};
-	range_for (auto &s, SoundObjects)
+	const auto refresh_cursor{sound_refresh_cursor};
+	sound_refresh_cursor = (refresh_cursor + sound_refresh_budget) % MAX_SOUND_OBJECTS;
+	for (auto &&[i, s] : enumerate(SoundObjects))
 	{
 		if (s.flags & SOF_USED)
 		{
+			const bool due{(i + MAX_SOUND_OBJECTS - refresh_cursor) % MAX_SOUND_OBJECTS < sound_refresh_budget};
 			oldvolume = s.volume;
 			const auto oldpan{s.pan};
 
@@ -612,7 +690,8 @@ void digi_sync_sounds()
 			}
 
 			if ( s.flags & SOF_LINK_TO_POS )	{
-				digi_update_sound_loc(viewer->orient, viewer->pos, vcsegptridx(viewer->segnum), s.link_type.pos.position, vcsegptridx(s.link_type.pos.segnum), s);
+				if (digi_sound_loc_stale(s, *viewer, s.link_type.pos.position, s.link_type.pos.segnum, due))
+					digi_update_sound_loc(viewer->orient, viewer->pos, vcsegptridx(viewer->segnum), s.link_type.pos.position, vcsegptridx(s.link_type.pos.segnum), s);
 			} else if ( s.flags & SOF_LINK_TO_OBJ )	{
 				auto &objp{[&vcobjptr, &s]() -> const object & {
 					if (Newdemo_state != ND_STATE_PLAYBACK)
@@ -635,7 +714,7 @@ void digi_sync_sounds()
 					}
 					s.flags = 0;	// Mark as dead, so some other sound can use this sound
 					continue;		// Go on to next sound...
-				} else {
+				} else if (digi_sound_loc_stale(s, *viewer, objp.pos, objp.segnum, due)) {
 					digi_update_sound_loc(viewer->orient, viewer->pos, vcsegptridx(viewer->segnum), objp.pos, vcsegptridx(objp.segnum), s);
 				}
 			}
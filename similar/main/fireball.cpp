@@ -434,8 +434,16 @@ static imobjptridx_t object_create_explosion_with_damage(const d_robot_info_arra
 		fix damage;
 		// -- now legal for badass explosions on a wall. Assert(obj_explosion_origin != NULL);
 
-		range_for (const auto &&obj_iter, vmobjptridx)
+		/* vm_vec_dist_quick can report about 10% less than the true
+		 * distance, so search a little beyond maxdistance.  Visit the
+		 * candidates in object number order, as a scan of every object
+		 * would, so that damage is applied in the same order.
+		 */
+		nearby_object_buffer candidates;
+		find_objects_near(candidates, segnum, obj_fireball->pos, vm_distance{maxdistance + maxdistance / 8}, nearby_object_order::objnum);
+		for (const auto &candidate : candidates)
 		{
+			const auto &&obj_iter{vmobjptridx(candidate.objnum)};
 			//	Weapons used to be affected by badass explosions, but this introduces serious problems.
 			//	When a smart bomb blows up, if one of its children goes right towards a nearby wall, it will
 			//	blow up, blowing up all the children.  So I remove it.  MK, 09/11/94
@@ -1553,7 +1561,7 @@ void do_explosion_sequence(const d_robot_info_array &Robot_info, object &obj)
 			explode_model(del_obj);		//explode a polygon model
 
 		//set some parm in explosion
-		//If num_objects < MAX_USED_OBJECTS, expl_obj could be set to dead before this setting causing the delete_obj not to be removed. If so, directly delete del_obj
+		//If num_objects < object_limit - RESERVED_FREE_OBJECTS, expl_obj could be set to dead before this setting causing the delete_obj not to be removed. If so, directly delete del_obj
 		if (expl_obj && !(expl_obj->flags & OF_SHOULD_BE_DEAD))
 		{
 			if (del_obj->movement_source == object::movement_type::physics) {
@@ -24,6 +24,12 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
  */
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <numeric>
+#include <tuple>
+#include <vector>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -45,6 +51,10 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "compiler-range_for.h"
 #include "d_levelstate.h"
 #include "segiter.h"
+#include "worker_pool.h"
+#if DXX_USE_EDITOR
+#include "editor/editor.h"
+#endif
 
 using std::min;
 
@@ -117,15 +127,41 @@ static ij_pair find_largest_normal(vms_vector t)
 	return {&vms_vector::z, &vms_vector::y, &vms_vector::x};
 }
 
-//see if a point in inside a face by projecting into 2d
-[[nodiscard]]
-static unsigned check_point_to_face(const vms_vector &checkp, const vms_vector &norm, const unsigned facenum, const unsigned nv, const vertnum_array_list_t &vertex_list)
+/* Projection and edge data for one face of a side.  The 2d edges are kept
+ * in parallel arrays padded to four entries, so the inside test runs the
+ * same straight-line code for triangles and quads, and the compiler can
+ * vectorize it.  A padding edge has zero length, and never marks a point
+ * as outside.
+ */
+struct fvi_face_data
 {
-	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
-	auto &Vertices = LevelSharedVertexState.get_vertices();
-///
-	//now do 2d check to see if point is in side
+	fix vms_vector::*i;
+	fix vms_vector::*j;
+	std::array<fix, 4> start_i{}, start_j{}, edge_i{}, edge_j{};
+	std::array<vms_vector, 4> edge_dir{};
+	std::array<fix, 4> edge_len{};
+};
+
+struct fvi_side_data
+{
+	vertnum_array_list_t vertex_list;
+	//lowest numbered vertex on the side, used as the point on its plane
+	vertnum_t plane_vertnum;
+	std::array<fvi_face_data, 2> faces;
+};
+
+/* Face data for every side of every segment.  Built on first use after a
+ * level is loaded.  find_vector_intersection can run on worker threads, so
+ * the table is built under a lock and published through
+ * Fvi_side_data_ready.  The editor can move vertices at any time, so the
+ * table is not used while the editor is open.
+ */
+static std::vector<per_side_array<fvi_side_data>> Fvi_side_data;
+static std::atomic<bool> Fvi_side_data_ready;
+static std::mutex Fvi_side_data_mutex;
 
+static void build_fvi_face_data(fvcvertptr &vcvertptr, const vms_vector &norm, const vertnum_array_list_t &vertex_list, const unsigned facenum, const unsigned nv, fvi_face_data &face)
+{
 	//project polygon onto plane by finding largest component of normal
 	ij_pair ij = find_largest_normal(norm);
 	if (norm.*ij.largest_normal <= 0)
@@ -133,63 +169,124 @@ static unsigned check_point_to_face(const vms_vector &checkp, const vms_vector &
 		using std::swap;
 		swap(ij.i, ij.j);
 	}
+	face.i = ij.i;
+	face.j = ij.j;
+	for (const auto edge : xrange(nv))
+	{
+		auto &v0 = *vcvertptr(vertex_list[facenum * 3 + edge]);
+		auto &v1 = *vcvertptr(vertex_list[facenum * 3 + ((edge + 1) % nv)]);
+		face.start_i[edge] = v0.*ij.i;
+		face.start_j[edge] = v0.*ij.j;
+		face.edge_i[edge] = v1.*ij.i - v0.*ij.i;
+		face.edge_j[edge] = v1.*ij.j - v0.*ij.j;
+		face.edge_len[edge] = vm_vec_normalized_dir(face.edge_dir[edge], v1, v0);
+	}
+}
+
+static void build_fvi_side_data(fvcvertptr &vcvertptr, const shared_segment &seg, const sidenum_t side, fvi_side_data &sd)
+{
+	auto &s = seg.sides[side];
+	const auto &&[num_faces, vertex_list] = create_abs_vertex_lists(seg, s, side);
+	sd = {};
+	sd.vertex_list = vertex_list;
+	if (num_faces == vertex_array_side_type::quad)
+	{
+		//a quad has only one face, so get_seg_masks never reports face 1
+		sd.plane_vertnum = *std::ranges::min_element(std::span(vertex_list).first<4>());
+		build_fvi_face_data(vcvertptr, s.normals[0], vertex_list, 0, 4, sd.faces[0]);
+	}
+	else
+	{
+		sd.plane_vertnum = std::min(vertex_list[0], vertex_list[2]);
+		build_fvi_face_data(vcvertptr, s.normals[0], vertex_list, 0, 3, sd.faces[0]);
+		build_fvi_face_data(vcvertptr, s.normals[1], vertex_list, 1, 3, sd.faces[1]);
+	}
+}
 
-	//now do the 2d problem in the i,j plane
+/* Return the face data for `side` of `seg`, from the per-level table when it
+ * can be used, else built into `scratch`.
+ */
+[[nodiscard]]
+static const fvi_side_data &get_fvi_side_data(const vcsegptridx_t seg, const sidenum_t side, fvi_side_data &scratch)
+{
+	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
+	auto &vcvertptr = LevelSharedVertexState.get_vertices().vcptr;
+#if DXX_USE_EDITOR
+	if (EditorWindow)
+	{
+		build_fvi_side_data(vcvertptr, seg, side, scratch);
+		return scratch;
+	}
+#endif
+	if (!Fvi_side_data_ready.load(std::memory_order_acquire))
+	{
+		const std::lock_guard lock(Fvi_side_data_mutex);
+		if (!Fvi_side_data_ready.load(std::memory_order_relaxed))
+		{
+			auto &vcsegptridx = LevelSharedSegmentState.get_segments().vcptridx;
+			Fvi_side_data.resize(vcsegptridx.count());
+			for (const auto &&segp : vcsegptridx)
+			{
+				auto &sides = Fvi_side_data[segp.get_unchecked_index()];
+				for (const auto sidenum : MAX_SIDES_PER_SEGMENT)
+					build_fvi_side_data(vcvertptr, segp, sidenum, sides[sidenum]);
+			}
+			Fvi_side_data_ready.store(true, std::memory_order_release);
+		}
+	}
+	return Fvi_side_data[seg.get_unchecked_index()][side];
+}
 
-	const auto check_i{checkp.*ij.i};
-	const auto check_j{checkp.*ij.j};
+//see if a point in inside a face by projecting into 2d
+[[nodiscard]]
+static unsigned check_point_to_face(const vms_vector &checkp, const fvi_face_data &face)
+{
+	//now do 2d check to see if point is in side
+
+	const auto check_i{checkp.*face.i};
+	const auto check_j{checkp.*face.j};
 
-	auto &vcvertptr = Vertices.vcptr;
 	unsigned edgemask{};
-	for (const auto edge : xrange(nv))
+	for (const auto edge : xrange(face.start_i.size()))
 	{
-		auto &v0 = *vcvertptr(vertex_list[facenum * 3 + edge]);
-		auto &v1 = *vcvertptr(vertex_list[facenum * 3 + ((edge + 1) % nv)]);
-		const vec2d edgevec{
-			.i = v1.*ij.i - v0.*ij.i,
-			.j = v1.*ij.j - v0.*ij.j
-		};
-		const vec2d checkvec{
-			.i = check_i - v0.*ij.i,
-			.j = check_j - v0.*ij.j
-		};
-		const fix64 d{fixmul64(checkvec.i, edgevec.j) - fixmul64(checkvec.j, edgevec.i)};
-		if (d < 0)              		//we are outside of triangle
-			edgemask |= (1<<edge);
+		/* Same arithmetic as fixmul64, written inline so that the loop
+		 * has no calls and can be vectorized.
+		 */
+		const fix64 d{(fix64{check_i - face.start_i[edge]} * fix64{face.edge_j[edge]}) / 65536 - (fix64{check_j - face.start_j[edge]} * fix64{face.edge_i[edge]}) / 65536};
+		//we are outside of triangle
+		edgemask |= unsigned{d < 0} << edge;
 	}
 	return edgemask;
 }
 
 //check if a sphere intersects a face
 [[nodiscard]]
-static intersection_type check_sphere_to_face(const vms_vector &pnt, const vms_vector &normal, const unsigned facenum, const unsigned nv, const fix rad, const vertnum_array_list_t &vertex_list)
+static intersection_type check_sphere_to_face(const vms_vector &pnt, const fvi_side_data &sd, const unsigned facenum, const fix rad)
 {
 	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
 	auto &Vertices = LevelSharedVertexState.get_vertices();
 	const auto checkp{pnt};
+	auto &face = sd.faces[facenum];
 	//now do 2d check to see if point is in side
 
-	auto edgemask{check_point_to_face(pnt, normal, facenum, nv, vertex_list)};
+	const auto edgemask{check_point_to_face(pnt, face)};
 
 	//we've gone through all the sides, are we inside?
 
 	if (edgemask == 0)
 		return intersection_type::Face;
 	else {
-		vms_vector edgevec;            //this time, real 3d vectors
-		int edgenum;
-
 		//get verts for edge we're behind
 
-		for (edgenum=0;!(edgemask&1);(edgemask>>=1),edgenum++);
+		const auto edgenum{std::countr_zero(edgemask)};
 
 		auto &vcvertptr = Vertices.vcptr;
-		auto &v0 = *vcvertptr(vertex_list[facenum * 3 + edgenum]);
-		auto &v1 = *vcvertptr(vertex_list[facenum * 3 + ((edgenum + 1) % nv)]);
+		auto &v0 = *vcvertptr(sd.vertex_list[facenum * 3 + edgenum]);
 
 		//check if we are touching an edge or point
 
-		const auto edgelen = vm_vec_normalized_dir(edgevec,v1,v0);
+		auto &edgevec = face.edge_dir[edgenum];		//this time, real 3d vectors
+		const auto edgelen{face.edge_len[edgenum]};
 		
 		//find point dist from planes of ends of edge
 
@@ -222,23 +319,15 @@ static intersection_type check_sphere_to_face(const vms_vector &pnt, const vms_v
 //facenum determines which of four possible faces we have
 //note: the seg parm is temporary, until the face itself has a point field
 [[nodiscard]]
-static std::optional<vms_vector> check_line_to_face(const vms_vector &p0, const vms_vector &p1, const shared_segment &seg, const sidenum_t side, const unsigned facenum, const unsigned nv, const fix rad)
+static std::optional<vms_vector> check_line_to_face(const vms_vector &p0, const vms_vector &p1, const shared_segment &seg, const sidenum_t side, const fvi_side_data &sd, const unsigned facenum, const fix rad)
 {
 	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
 	auto &Vertices = LevelSharedVertexState.get_vertices();
 	auto &s = seg.sides[side];
 	const vms_vector &norm = s.normals[facenum];
 
-	const auto &&[num_faces, vertex_list] = create_abs_vertex_lists(seg, s, side);
-
 	//use lowest point number
-	const auto vertnum{
-		(num_faces != vertex_array_side_type::quad)
-			? std::min(vertex_list[0], vertex_list[2])
-			: *std::ranges::min_element(std::span(vertex_list).first<4>())
-	};
-
-	const auto result{find_plane_line_intersection(Vertices.vcptr(vertnum), norm, p0, p1, rad)};
+	const auto result{find_plane_line_intersection(Vertices.vcptr(sd.plane_vertnum), norm, p0, p1, rad)};
 	/* If `hit_type == None`, then `hit_point` is undefined, because no hit
 	 * occurred.
 	 *
@@ -258,7 +347,7 @@ static std::optional<vms_vector> check_line_to_face(const vms_vector &p0, const
 			? hit_point
 			: (vm_vec_scale_add2(projected_point = hit_point, norm, -rad), projected_point)
 	};
-	if (check_sphere_to_face(checkp, s.normals[facenum], facenum, nv, rad, vertex_list) == intersection_type::None)
+	if (check_sphere_to_face(checkp, sd, facenum, rad) == intersection_type::None)
 		return std::nullopt;
 	return result;
 }
@@ -302,32 +391,25 @@ static std::optional<std::pair<fix, fix>> check_line_to_line(const vms_vector &p
 //the plane of a side.  In this case, we must do checks against the edge
 //of faces
 [[nodiscard]]
-static std::optional<vms_vector> special_check_line_to_face(const vms_vector &p0, const vms_vector &p1, const shared_segment &seg, const sidenum_t side, const unsigned facenum, const unsigned nv, const fix rad)
+static std::optional<vms_vector> special_check_line_to_face(const vms_vector &p0, const vms_vector &p1, const shared_segment &seg, const sidenum_t side, const fvi_side_data &sd, const unsigned facenum, const fix rad)
 {
 	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
 	auto &Vertices = LevelSharedVertexState.get_vertices();
 	fix edge_t2{0};
-	int edgenum;
-	auto &s = seg.sides[side];
-
-	//calc some basic stuff
-
-	const auto &&vertex_list = create_abs_vertex_lists(seg, s, side).vertex_list;
+	auto &face = sd.faces[facenum];
 
 	//figure out which edge(s) to check against
 
-	unsigned edgemask = check_point_to_face(p0, s.normals[facenum], facenum, nv, vertex_list);
+	const auto edgemask{check_point_to_face(p0, face)};
 
 	if (edgemask == 0)
-		return check_line_to_face(p0, p1, seg, side, facenum, nv, rad);
+		return check_line_to_face(p0, p1, seg, side, sd, facenum, rad);
 
-	for (edgenum=0;!(edgemask&1);edgemask>>=1,edgenum++);
+	const auto edgenum{std::countr_zero(edgemask)};
 
 	auto &vcvertptr = Vertices.vcptr;
-	auto &edge_v0 = *vcvertptr(vertex_list[facenum * 3 + edgenum]);
-	auto &edge_v1 = *vcvertptr(vertex_list[facenum * 3 + ((edgenum + 1) % nv)]);
-
-	auto edge_vec{vm_vec_build_sub(edge_v1, edge_v0)};
+	auto &edge_v0 = *vcvertptr(sd.vertex_list[facenum * 3 + edgenum]);
+	auto &edge_vec = face.edge_dir[edgenum];
 
 	//is the start point already touching the edge?
 
@@ -335,7 +417,7 @@ static std::optional<vms_vector> special_check_line_to_face(const vms_vector &p0
 
 	//first, find point of closest approach of vec & edge
 
-	const auto edge_len{vm_vec_normalize(edge_vec)};
+	const auto edge_len{face.edge_len[edgenum]};
 	auto move_vec{vm_vec_build_sub(p1, p0)};
 	const auto move_len{vm_vec_normalize(move_vec)};
 
@@ -602,6 +684,8 @@ struct fvi_segments_visited_t : public fvi_segment_visit_count_t, public visited
 namespace dsx {
 namespace {
 static fvi_hit_type fvi_sub(const fvi_query &, vms_vector &intp, segnum_t &ints, const vcsegptridx_t startseg, fix rad, fvi_info::segment_array_t &seglist, segnum_t entry_seg, fvi_segments_visited_t &visited, sidenum_t &fvi_hit_side, icsegidx_t &fvi_hit_side_seg, unsigned &fvi_nest_count, icsegidx_t &fvi_hit_pt_seg, const vms_vector *&wall_norm, icobjidx_t &fvi_hit_object);
+static bool check_fvi_start(const vms_vector &p0, segnum_t startseg, fvi_info &hit_data);
+static fvi_hit_type find_vector_intersection_from(const fvi_query &fq, segnum_t startseg, fix rad, fvi_info &hit_data, fvi_segments_visited_t &visited);
 }
 
 //What the hell is fvi_hit_seg for???
@@ -618,40 +702,125 @@ static fvi_hit_type fvi_sub(const fvi_query &, vms_vector &intp, segnum_t &ints,
 //Returns the hit_data->hit_type
 fvi_hit_type find_vector_intersection(const fvi_query fq, const segnum_t startseg, const fix rad, fvi_info &hit_data)
 {
-	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
-	auto &Vertices = LevelSharedVertexState.get_vertices();
-	vms_vector hit_pnt;
-
-	icobjidx_t fvi_hit_object = object_none;	// object number of object hit in last find_vector_intersection call.
-
 	//check to make sure start point is in seg its supposed to be in
 	//Assert(check_point_in_seg(p0,startseg,0).centermask==0);	//start point not in seg
+	if (!check_fvi_start(fq.p0, startseg, hit_data))
+		return fvi_hit_type::BadP0;
+	fvi_segments_visited_t visited;
+	return find_vector_intersection_from(fq, startseg, rad, hit_data, visited);
+}
+
+void find_vector_intersections(const std::span<const fvi_batch_query> queries, const std::span<fvi_batch_result> results, const fvi_batch_parallel parallel)
+{
+	assert(queries.size() == results.size());
+	const std::size_t count{std::min(queries.size(), results.size())};
+	if (!count)
+		return;
+	/* Sort by start segment, then by start point, so that queries which
+	 * begin at the same place are adjacent.  Each query still writes only
+	 * its own result, so the order does not affect the results.
+	 */
+	std::vector<uint32_t> order(count);
+	std::iota(order.begin(), order.end(), 0u);
+	const auto same_start{[queries](const uint32_t a, const uint32_t b) {
+		auto &qa{queries[a]};
+		auto &qb{queries[b]};
+		return qa.startseg == qb.startseg && qa.fq.p0 == qb.fq.p0;
+	}};
+	std::sort(order.begin(), order.end(), [queries](const uint32_t a, const uint32_t b) {
+		auto &qa{queries[a]};
+		auto &qb{queries[b]};
+		auto &pa{qa.fq.p0};
+		auto &pb{qb.fq.p0};
+		return std::tie(qa.startseg, pa.x, pa.y, pa.z, a) < std::tie(qb.startseg, pb.x, pb.y, pb.z, b);
+	});
+	std::vector<uint32_t> group_begin;
+	for (const auto i : xrange(count))
+		if (!i || !same_start(order[i - 1], order[i]))
+			group_begin.emplace_back(i);
+	group_begin.emplace_back(count);
+	const auto run_group{[queries, results, &order, &group_begin](const std::size_t g) {
+		const auto b{group_begin[g]}, e{group_begin[g + 1]};
+		auto &first{queries[order[b]]};
+		if (!check_fvi_start(first.fq.p0, first.startseg, results[order[b]].hit_data))
+		{
+			for (const auto i : xrange(b, e))
+			{
+				auto &q{queries[order[i]]};
+				auto &r{results[order[i]]};
+				if (i != b)
+					check_fvi_start(q.fq.p0, q.startseg, r.hit_data);
+				r.hit_type = fvi_hit_type::BadP0;
+			}
+			return;
+		}
+		/* The visited set is cleared between queries, rather than
+		 * constructed for each one.
+		 */
+		fvi_segments_visited_t visited;
+		for (const auto i : xrange(b, e))
+		{
+			auto &q{queries[order[i]]};
+			auto &r{results[order[i]]};
+			if (i != b)
+				visited = {};
+			r.hit_type = find_vector_intersection_from(q.fq, q.startseg, q.rad, r.hit_data, visited);
+		}
+	}};
+	const std::size_t groups{group_begin.size() - 1};
+	if (parallel == fvi_batch_parallel::yes && groups > 1)
+		run_parallel(groups, [&run_group](const std::size_t g) { run_group(g); });
+	else
+		for (const auto g : xrange(groups))
+			run_group(g);
+}
+
+namespace {
 
+/* Check that `p0` is in `startseg`.  If it is not, fill in `hit_data` as
+ * find_vector_intersection does for a bad start point and return false.
+ */
+static bool check_fvi_start(const vms_vector &p0, const segnum_t startseg, fvi_info &hit_data)
+{
 	// invalid segnum, so say there is no hit.
 	if (startseg > Highest_segment_index)
 	{
 		assert(startseg <= Highest_segment_index);
-		hit_data.hit_pnt = fq.p0;
+		hit_data.hit_pnt = p0;
 		hit_data.hit_seg = segnum_t{};
 		hit_data.hit_object = 0;
 		hit_data.hit_side = side_none;
 		hit_data.hit_side_seg = segment_none;
-		return fvi_hit_type::BadP0;
+		return false;
 	}
 
-	auto &vcvertptr = Vertices.vcptr;
+	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
+	auto &Vertices = LevelSharedVertexState.get_vertices();
 	// Viewer is not in segment as claimed, so say there is no hit.
-	if (get_seg_masks(vcvertptr, fq.p0, vcsegptr(startseg), 0).centermask != sidemask_t{})
+	if (get_seg_masks(Vertices.vcptr, p0, vcsegptr(startseg), 0).centermask != sidemask_t{})
 	{
-		hit_data.hit_pnt = fq.p0;
+		hit_data.hit_pnt = p0;
 		hit_data.hit_seg = startseg;
 		hit_data.hit_side = side_none;
 		hit_data.hit_object = 0;
 		hit_data.hit_side_seg = segment_none;
-		return fvi_hit_type::BadP0;
+		return false;
 	}
+	return true;
+}
+
+/* The body of find_vector_intersection, after the start point has been
+ * validated.  `visited` must be clear on entry.
+ */
+static fvi_hit_type find_vector_intersection_from(const fvi_query &fq, const segnum_t startseg, const fix rad, fvi_info &hit_data, fvi_segments_visited_t &visited)
+{
+	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
+	auto &Vertices = LevelSharedVertexState.get_vertices();
+	auto &vcvertptr = Vertices.vcptr;
+	vms_vector hit_pnt;
+
+	icobjidx_t fvi_hit_object = object_none;	// object number of object hit in last find_vector_intersection call.
 
-	fvi_segments_visited_t visited;
 	visited[startseg] = true;
 
 	sidenum_t fvi_hit_side;
@@ -757,6 +926,8 @@ fvi_hit_type find_vector_intersection(const fvi_query fq, const segnum_t startse
 	return hit_type;
 }
 
+}
+
 namespace {
 
 static int check_trans_wall(const vms_vector &pnt, vcsegptridx_t seg, sidenum_t sidenum, int facenum);
@@ -900,7 +1071,8 @@ static fvi_hit_type fvi_sub(const fvi_query &fq, vms_vector &intp, segnum_t &int
 		{
 			if (endmask < bit)
 				break;
-			const unsigned nv{get_side_is_quad(startseg->shared_segment::sides[side]) ? 4u : 3u};
+			fvi_side_data scratch_side_data;
+			auto &sd = get_fvi_side_data(startseg, side, scratch_side_data);
 			// commented out by mk on 02/13/94:: if ((num_faces=seg->sides[side].num_faces)==0) num_faces=1;
 
 			for (int face=0; face < 2; ++face, bit <<= 1)
@@ -916,8 +1088,8 @@ static fvi_hit_type fvi_sub(const fvi_query &fq, vms_vector &intp, segnum_t &int
 					// face_hit_type: in what way did we hit the face?
 					const auto &&opt_hit_point{
 						(startmask & bit)		//start was also through.  Do extra check
-							? special_check_line_to_face(fq.p0, fq.p1, startseg, side, face, nv, rad)
-							: check_line_to_face(fq.p0, fq.p1, startseg, side, face, nv, rad)
+							? special_check_line_to_face(fq.p0, fq.p1, startseg, side, sd, face, rad)
+							: check_line_to_face(fq.p0, fq.p1, startseg, side, sd, face, rad)
 					};
 
 					if (opt_hit_point)
@@ -1161,6 +1333,13 @@ fvi_hitpoint find_hitpoint_uv(const vms_vector &pnt, const cscusegment seg, cons
 }
 
 namespace {
+
+/* AI perception may run find_vector_intersection on worker threads.  The
+ * texture merge and RLE caches used to look up transparent pixels are not
+ * thread-safe, so serialize access to them.
+ */
+std::mutex Trans_wall_texture_mutex;
+
 //check if a particular point on a wall is a transparent pixel
 //returns 1 if can pass though the wall, else 0
 int check_trans_wall(const vms_vector &pnt, const vcsegptridx_t seg, const sidenum_t sidenum, const int facenum)
@@ -1181,6 +1360,7 @@ int check_trans_wall(const vms_vector &pnt, const vcsegptridx_t seg, const siden
 	auto &v = hitpoint.v;
 
 	const auto tmap_num{side.tmap_num};
+	const std::lock_guard lock{Trans_wall_texture_mutex};
 	const grs_bitmap &rbm = (side.tmap_num2 != texture2_value::None)
 		? texmerge_get_cached_bitmap(GameBitmaps, Textures, tmap_num, side.tmap_num2)
 		/* gcc-13 issues a -Wdangling-reference warning if this lambda returns
@@ -1236,12 +1416,11 @@ static sphere_intersects_wall_result sphere_intersects_wall(fvcsegptridx &vcsegp
 			{
 				if (facemask & bit) {            //on the back of this face
 					//did we go through this wall/door?
-					auto &sidep = sseg.sides[side];
-					const auto &&[num_faces, vertex_list] = create_abs_vertex_lists(sseg, sidep, side);
+					fvi_side_data scratch_side_data;
+					auto &sd = get_fvi_side_data(seg, side, scratch_side_data);
 
 					//in what way did we hit the face?
-					const auto face_hit_type = check_sphere_to_face(pnt, sidep.normals[face],
-										face, ((num_faces == vertex_array_side_type::quad) ? 4 : 3), rad, vertex_list);
+					const auto face_hit_type = check_sphere_to_face(pnt, sd, face, rad);
 
 					if (face_hit_type != intersection_type::None)
 					{            //through this wall/door
@@ -1272,3 +1451,9 @@ sphere_intersects_wall_result sphere_intersects_wall(fvcsegptridx &vcsegptridx,
 	fvi_segments_visited_t visited;
 	return sphere_intersects_wall(vcsegptridx, vcvertptr, pnt, seg, rad, visited);
 }
+
+void invalidate_fvi_side_data()
+{
+	Fvi_side_data_ready.store(false, std::memory_order_relaxed);
+	Fvi_side_data.clear();
+}
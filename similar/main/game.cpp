@@ -116,6 +116,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "d_enumerate.h"
 #include "d_levelstate.h"
 #include "d_range.h"
+#include "d_zip.h"
 #include "compiler-range_for.h"
 #include "partial_range.h"
 #include "segiter.h"
@@ -637,7 +638,12 @@ void reset_time()
 
 }
 
-void calc_frame_time()
+namespace {
+
+/* Wait until the frame limiter allows another frame, and set FrameTime to
+ * the time since the previous frame.
+ */
+static void wait_for_frame()
 {
 	fix last_frametime = FrameTime;
 
@@ -670,7 +676,12 @@ void calc_frame_time()
 
 	if (FrameTime < 0)				//if bogus frametime...
 		FrameTime = (last_frametime==0?1:last_frametime);		//...then use time from last frame
+}
 
+/* Advance the game clock by FrameTime.
+ */
+static void advance_game_time()
+{
 	GameTime64 += FrameTime;
 
 	calc_d_tick();
@@ -679,6 +690,14 @@ void calc_frame_time()
 #endif
 }
 
+}
+
+void calc_frame_time()
+{
+	wait_for_frame();
+	advance_game_time();
+}
+
 namespace dsx {
 
 #if DXX_USE_EDITOR
@@ -1571,6 +1590,8 @@ void show_netgame_help()
 	DXX_MENUITEM(VERB, TEXT, "SHIFT-LEFT\t  FAST BACKWARD", DEMOHELP_FAST_BACKWARD)	\
 	DXX_MENUITEM(VERB, TEXT, "CTRL-RIGHT\t  JUMP TO END", DEMOHELP_JUMP_END)	\
 	DXX_MENUITEM(VERB, TEXT, "CTRL-LEFT\t  JUMP TO START", DEMOHELP_JUMP_START)	\
+	DXX_MENUITEM(VERB, TEXT, "PAGE DOWN\t  JUMP FORWARD", DEMOHELP_JUMP_FORWARD)	\
+	DXX_MENUITEM(VERB, TEXT, "PAGE UP\t  JUMP BACKWARD", DEMOHELP_JUMP_BACKWARD)	\
 	_DXX_HELP_MENU_HINT_CMD_KEY(VERB, DEMOHELP)	\
 
 enum {
@@ -1720,6 +1741,279 @@ void game_disable_cheats()
 	cheats = {};
 }
 
+namespace dsx {
+
+namespace {
+
+/* With -fixed-tickrate, GameProcessFrame runs in steps of a fixed length,
+ * no matter how long each frame takes to draw.  Objects are drawn
+ * interpolated between their positions before and after the latest step,
+ * so motion stays smooth when the frame rate is not a multiple of the step
+ * rate.
+ */
+struct fixed_step_object
+{
+	vms_vector pos;
+	vms_matrix orient;
+	object_signature_t signature;
+	segnum_t segnum;
+};
+
+struct fixed_step_saved_object
+{
+	objnum_t objnum;
+	vms_vector pos;
+	vms_matrix orient;
+};
+
+/* The control times that kconfig_end_loop rebuilds on every frame. */
+constexpr std::array<fix control_info::*, 6> fixed_step_control_times{{
+	&control_info::pitch_time,
+	&control_info::vertical_thrust_time,
+	&control_info::heading_time,
+	&control_info::sideways_thrust_time,
+	&control_info::bank_time,
+	&control_info::forward_thrust_time,
+}};
+
+struct fixed_step_state
+{
+	/* Time that has passed, but has not been simulated yet. */
+	fix accumulator;
+	/* Control times read on frames since the last step.  Most frames run
+	 * no step when the frame rate is above the step rate, so the input of
+	 * each frame is added here until a step applies it.
+	 */
+	std::array<fix, fixed_step_control_times.size()> pending_controls;
+	/* Number of valid entries in `previous`.  This is 0 until the first
+	 * step after the game window is set up.
+	 */
+	objnum_t previous_count;
+	/* Object transforms as they were before the latest step. */
+	std::array<fixed_step_object, MAX_OBJECTS> previous;
+	/* Simulated transforms of the objects that are currently moved to
+	 * their interpolated positions.
+	 */
+	std::vector<fixed_step_saved_object> saved;
+};
+
+static fixed_step_state Fixed_step_state;
+
+/* Multiplayer timing and demo playback both depend on running exactly one
+ * GameProcessFrame per frame, so fixed stepping is single player only.
+ */
+static unsigned get_fixed_step_rate()
+{
+	if (+(Game_mode & GM_MULTI) || Newdemo_state == ND_STATE_PLAYBACK)
+		return 0;
+	return CGameArg.SysFixedTickRate;
+}
+
+static void reset_fixed_step_state(fixed_step_state &s)
+{
+	s.accumulator = 0;
+	s.pending_controls = {};
+	s.previous_count = 0;
+}
+
+static void save_fixed_step_objects(fixed_step_state &s)
+{
+	auto &Objects = LevelUniqueObjectState.Objects;
+	const objnum_t count = Objects.get_count();
+	for (const auto i : xrange(count))
+	{
+		auto &obj = *Objects.vcptr(i);
+		auto &p = s.previous[i];
+		p.pos = obj.pos;
+		p.orient = obj.orient;
+		p.signature = obj.signature;
+		p.segnum = obj.type == object_type::OBJ_NONE ? segment_none : obj.segnum;
+	}
+	s.previous_count = count;
+}
+
+static window_event_result game_process_fixed_steps(const d_level_shared_robot_info_state &LevelSharedRobotInfoState, control_info &Controls, fixed_step_state &s, const unsigned rate)
+{
+	const fix step = F1_0 / rate;
+	wait_for_frame();
+	const auto frame_time{FrameTime};
+	/* The controls of this frame were scaled by the length of the previous
+	 * frame, so they add up to the input over the time since the last step.
+	 */
+	for (auto &&[pending, member] : zip(s.pending_controls, fixed_step_control_times))
+		pending += Controls.*member;
+	/* After a long stall, drop the time that cannot be caught up, rather
+	 * than running a burst of steps.
+	 */
+	s.accumulator = std::min(s.accumulator + frame_time, step * 4);
+	auto result = window_event_result::ignored;
+	for (unsigned steps = s.accumulator / step; steps; --steps)
+	{
+		s.accumulator -= step;
+		/* Share the pending input evenly among the steps of this frame. */
+		for (auto &&[pending, member] : zip(s.pending_controls, fixed_step_control_times))
+		{
+			const fix share = pending / static_cast<fix>(steps);
+			Controls.*member = share;
+			pending -= share;
+		}
+		save_fixed_step_objects(s);
+		FrameTime = step;
+		advance_game_time();
+		result = std::max(GameProcessFrame(LevelSharedRobotInfoState), result);
+		if (result >= window_event_result::close)
+			break;
+	}
+	/* kconfig_end_loop scales the next frame's input by this. */
+	FrameTime = frame_time;
+	return result;
+}
+
+/* Move each object that was present, in the same segment, both before and
+ * after the latest step, to its interpolated position.  An object that
+ * changed segment is left alone, since its interpolated position might not
+ * be in either segment.
+ */
+static void interpolate_fixed_step_objects(fixed_step_state &s, const unsigned rate)
+{
+	s.saved.clear();
+	auto &Objects = LevelUniqueObjectState.Objects;
+	const fix step = F1_0 / rate;
+	const fix alpha = fixdiv(s.accumulator, step);
+	const objnum_t count = std::min<objnum_t>(s.previous_count, Objects.get_count());
+	for (const auto i : xrange(count))
+	{
+		auto &obj = *Objects.vmptr(i);
+		auto &p = s.previous[i];
+		if (obj.type == object_type::OBJ_NONE || obj.signature != p.signature || obj.segnum != p.segnum)
+			continue;
+		if (obj.pos == p.pos && obj.orient.fvec == p.orient.fvec && obj.orient.uvec == p.orient.uvec)
+			continue;
+		s.saved.push_back({i, obj.pos, obj.orient});
+		obj.pos = vm_vec_scale_add(p.pos, vm_vec_build_sub(obj.pos, p.pos), alpha);
+		const auto fvec{vm_vec_scale_add(p.orient.fvec, vm_vec_build_sub(obj.orient.fvec, p.orient.fvec), alpha)};
+		const auto uvec{vm_vec_scale_add(p.orient.uvec, vm_vec_build_sub(obj.orient.uvec, p.orient.uvec), alpha)};
+		/* A half turn within one step has no midpoint.  Draw it at its
+		 * simulated orientation.
+		 */
+		if (fvec != vms_vector{})
+			obj.orient = vm_vector_to_matrix_u(fvec, uvec);
+	}
+}
+
+static void restore_fixed_step_objects(fixed_step_state &s)
+{
+	auto &Objects = LevelUniqueObjectState.Objects;
+	for (auto &saved : s.saved)
+	{
+		auto &obj = *Objects.vmptr(saved.objnum);
+		obj.pos = saved.pos;
+		obj.orient = saved.orient;
+	}
+	s.saved.clear();
+}
+
+/* With -demo-capture, demo playback advances by exactly one capture
+ * interval per drawn frame, without waiting for the frame limiter, and
+ * every drawn frame is appended to a raw RGB24 file.  The file has no
+ * header; its dimensions are logged when capture starts.
+ */
+struct demo_capture_state
+{
+	RAIIPHYSFS_File file;
+	uint16_t width, height;
+	unsigned frames;
+	std::vector<uint8_t> pixels;
+};
+
+static demo_capture_state Demo_capture_state;
+
+static unsigned get_demo_capture_rate()
+{
+	if (Newdemo_state != ND_STATE_PLAYBACK || Newdemo_vcr_state != ND_STATE_PLAYBACK)
+		return 0;
+	return CGameArg.SysDemoCaptureRate;
+}
+
+static void stop_demo_capture(demo_capture_state &dc)
+{
+	if (!dc.file)
+		return;
+	dc.file.reset();
+	dc.pixels = {};
+	con_printf(CON_NORMAL, "Captured %u demo frames", dc.frames);
+}
+
+static void capture_demo_frame(demo_capture_state &dc)
+{
+	const auto &bm = grd_curscreen->sc_canvas.cv_bitmap;
+	const uint16_t w = bm.bm_w, h = bm.bm_h;
+	if (!dc.file)
+	{
+#define DXX_DEMO_CAPTURE_FILENAME	SCRNS_DIR "demo-capture.rgb"
+		if (!PHYSFS_exists(SCRNS_DIR))
+			PHYSFS_mkdir(SCRNS_DIR);
+		auto &&[file, physfserr] = PHYSFSX_openWriteBuffered(DXX_DEMO_CAPTURE_FILENAME);
+		if (!file)
+		{
+			con_printf(CON_URGENT, "Failed to open " DXX_DEMO_CAPTURE_FILENAME " for writing: %s", PHYSFS_getErrorByCode(physfserr));
+			CGameArg.SysDemoCaptureRate = 0;
+			return;
+		}
+		dc.file = std::move(file);
+		dc.width = w;
+		dc.height = h;
+		dc.frames = 0;
+		con_printf(CON_NORMAL, "Capturing demo to " DXX_DEMO_CAPTURE_FILENAME " as %ux%u rgb24 at %u frames per second", w, h, CGameArg.SysDemoCaptureRate);
+#undef DXX_DEMO_CAPTURE_FILENAME
+	}
+	else if (w != dc.width || h != dc.height)
+		/* The output has no way to describe a change of size, so frames
+		 * drawn at another size are dropped.
+		 */
+		return;
+	const std::size_t stride = w * 3;
+	dc.pixels.resize(stride * h);
+#if DXX_USE_OGL
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+#if !DXX_USE_OGLES
+	glReadBuffer(GL_BACK);
+#endif
+	glReadPixels(0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, dc.pixels.data());
+	/* OpenGL returns the bottom row first, but video encoders expect the
+	 * top row first.
+	 */
+	for (auto p = dc.pixels.end(); p != dc.pixels.begin();)
+	{
+		p -= stride;
+		if (PHYSFS_writeBytes(dc.file, &*p, stride) != static_cast<PHYSFS_sint64>(stride))
+			break;
+	}
+#else
+	palette_array_t pal;
+	gr_palette_read(pal);
+	auto o = dc.pixels.begin();
+	for (const uint_fast32_t y : xrange(h))
+	{
+		const auto row = &bm.bm_data[y * bm.bm_rowsize];
+		for (const uint_fast32_t x : xrange(w))
+		{
+			/* The hardware palette has 6 bits per channel. */
+			auto &c = pal[row[x]];
+			*o++ = c.r << 2;
+			*o++ = c.g << 2;
+			*o++ = c.b << 2;
+		}
+	}
+	PHYSFS_writeBytes(dc.file, dc.pixels.data(), dc.pixels.size());
+#endif
+	++dc.frames;
+}
+
+}
+
+}
+
 //	game_setup()
 // ----------------------------------------------------------------------------
 
@@ -1754,6 +2048,7 @@ game_window *game_setup()
 	Game_suspended = 0;
 	reset_time();
 	FrameTime = 0;			//make first frame zero
+	reset_fixed_step_state(Fixed_step_state);
 
 	fix_object_segs();
 	if (CGameArg.SysAutoRecordDemo && Newdemo_state == ND_STATE_NORMAL)
@@ -1817,10 +2112,25 @@ window_event_result game_window::event_handler(const d_event &event)
 			return ReadControls(LevelSharedRobotInfoState, event, Controls);
 
 		case event_type::window_draw:
+		{
+			const auto fixed_step_rate{get_fixed_step_rate()};
 			if (!time_paused)
 			{
-				calc_frame_time();
-				result = GameProcessFrame(LevelSharedRobotInfoState);
+				if (fixed_step_rate)
+					result = game_process_fixed_steps(LevelSharedRobotInfoState, Controls, Fixed_step_state, fixed_step_rate);
+				else
+				{
+					reset_fixed_step_state(Fixed_step_state);
+					if (const auto capture_rate{get_demo_capture_rate()})
+					{
+						FrameTime = F1_0 / capture_rate;
+						reset_time();
+						advance_game_time();
+					}
+					else
+						calc_frame_time();
+					result = GameProcessFrame(LevelSharedRobotInfoState);
+				}
 			}
 
 			if (!Automap_active)		// efficiency hack
@@ -1829,11 +2139,18 @@ window_event_result game_window::event_handler(const d_event &event)
 					init_cockpit();
 					force_cockpit_redraw=0;
 				}
+				if (fixed_step_rate)
+					interpolate_fixed_step_objects(Fixed_step_state, fixed_step_rate);
 				game_render_frame(LevelSharedRobotInfoState.Robot_info, Controls);
+				restore_fixed_step_objects(Fixed_step_state);
+				if (get_demo_capture_rate())
+					capture_demo_frame(Demo_capture_state);
 			}
 			break;
+		}
 
 		case event_type::window_close:
+			stop_demo_capture(Demo_capture_state);
 			digi_stop_digi_sounds();
 
 			if ( (Newdemo_state == ND_STATE_RECORDING) || (Newdemo_state == ND_STATE_PAUSED) )
@@ -2456,32 +2773,24 @@ namespace {
 //	Return true if path created, else return false.
 static int mark_player_path_to_segment(const d_vclip_array &Vclip, fvmobjptridx &vmobjptridx, fvmsegptridx &vmsegptridx, segnum_t segnum)
 {
-	int		player_hide_index=-1;
+	std::array<point_seg, 200> player_path;
 
 	if (LevelUniqueObjectState.Level_path_created)
 		return 0;
 	LevelUniqueObjectState.Level_path_created = 1;
 
 	auto objp = vmobjptridx(ConsoleObject);
-	const auto &&cr = create_path_points(objp, create_path_unused_robot_info, objp->segnum, segnum, Point_segs_free_ptr, 100, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none);
+	const auto &&cr = create_path_points(objp, create_path_unused_robot_info, objp->segnum, segnum, player_path.begin(), 100, create_path_random_flag::nonrandom, create_path_safety_flag::unsafe, segment_none);
 	const unsigned player_path_length = cr.second;
 	if (cr.first == create_path_result::early)
 		return 0;
 
-	player_hide_index = Point_segs_free_ptr - Point_segs;
-	Point_segs_free_ptr += player_path_length;
-
-	if (Point_segs_free_ptr - Point_segs + MAX_PATH_LENGTH*2 > MAX_POINT_SEGS) {
-		ai_reset_all_paths();
-		return 0;
-	}
-
 	for (int i=1; i<player_path_length; i++) {
 		vms_vector	seg_center;
 
-		seg_center = Point_segs[player_hide_index+i].point;
+		seg_center = player_path[i].point;
 
-		const auto &&obj = obj_create(LevelUniqueObjectState, LevelSharedSegmentState, LevelUniqueSegmentState, object_type::OBJ_POWERUP, underlying_value(powerup_type_t::POW_ENERGY), vmsegptridx(Point_segs[player_hide_index+i].segnum), seg_center, &vmd_identity_matrix, Powerup_info[powerup_type_t::POW_ENERGY].size, object::control_type::powerup, object::movement_type::None, render_type::RT_POWERUP);
+		const auto &&obj = obj_create(LevelUniqueObjectState, LevelSharedSegmentState, LevelUniqueSegmentState, object_type::OBJ_POWERUP, underlying_value(powerup_type_t::POW_ENERGY), vmsegptridx(player_path[i].segnum), seg_center, &vmd_identity_matrix, Powerup_info[powerup_type_t::POW_ENERGY].size, object::control_type::powerup, object::movement_type::None, render_type::RT_POWERUP);
 		if (obj == object_none) {
 			Int3();		//	Unable to drop energy powerup for path
 			return 1;
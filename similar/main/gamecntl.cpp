@@ -683,6 +683,10 @@ static window_event_result HandleDemoKey(int key)
 		case KEY_CTRLED + KEY_LEFT:
 			return newdemo_goto_beginning();
 			break;
+		case KEY_PAGEUP:
+			return newdemo_seek_frames(-ND_SEEK_JUMP_FRAMES);
+		case KEY_PAGEDOWN:
+			return newdemo_seek_frames(ND_SEEK_JUMP_FRAMES);
 
 		KEY_MAC(case KEY_COMMAND+KEY_P:)
 		case KEY_PAUSE:
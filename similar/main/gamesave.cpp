@@ -63,6 +63,8 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "gamepal.h"
 #include "physics.h"
 #include "laser.h"
+#include "ai.h"
+#include "fvi.h"
 #include "multi.h"
 #include "makesig.h"
 #include "textures.h"
@@ -1364,6 +1366,9 @@ int load_level(
 	if (Gamesave_current_version < 5)
 		PHYSFSX_skipBytes<4>(LoadFile);		//was hostagetext_offset
 	init_exploding_walls();
+	invalidate_segment_bounds();
+	invalidate_ai_path_heuristic();
+	invalidate_fvi_side_data();
 #if DXX_BUILD_DESCENT == 2
 	if (Gamesave_current_version >= 8) {    //read dummy data
 		PHYSFSX_skipBytes<4 + 2 + 1>(LoadFile);
@@ -1106,6 +1106,7 @@ void LoadLevel(int level_num,int page_in_textures)
 
 	plr = save_player;
 
+	digi_preload_sounds();
 	auto &vcvertptr = Vertices.vcptr;
 	set_sound_sources(vcsegptridx, vcvertptr);
 
@@ -1804,6 +1805,9 @@ static window_event_result (AdvanceLevel)(
 #endif
 	if (Current_level_num != Current_mission->last_level)
 	{
+		/* Prepare the next level's song while the score screen is shown. */
+		if (Current_level_num > 0)
+			songs_prefetch_level_song(Current_level_num + 1);
 		if (+(Game_mode & GM_MULTI))
 		{
 			const auto result = multi_endlevel_score();
@@ -899,7 +899,7 @@ per_gauge_inset_window_view_array<gauge_inset_window> inset_window;
 static inline void hud_bitblt_free(grs_canvas &canvas, const unsigned x, const unsigned y, const unsigned w, const unsigned h, grs_bitmap &bm)
 {
 #if DXX_USE_OGL
-	ogl_ubitmapm_cs(canvas, x, y, w, h, bm, ogl_colors::white);
+	ogl_ubitmapm_cs(canvas, x, y, w, h, ogl_hud_atlas_bitmap(bm), ogl_colors::white);
 #else
 	gr_ubitmapm(canvas, x, y, bm);
 #endif
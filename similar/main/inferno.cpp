@@ -176,6 +176,7 @@ static void print_commandline_help()
 	VERB("\n System Options:\n\n")	\
 	VERB("  -nonicefps                    Don't free CPU-cycles\n")	\
 	VERB("  -maxfps <n>                   Set maximum framerate to <n>\n\t\t\t\t(default: " DXX_STRINGIZE(MAXIMUM_FPS) ", available: " DXX_STRINGIZE(MINIMUM_FPS) "-" DXX_STRINGIZE(MAXIMUM_FPS) ")\n")	\
+	VERB("  -fixed-tickrate <n>           Run the simulation at <n> steps per second, and\n\t\t\t\tinterpolate between steps when drawing\n\t\t\t\t(default: 0, step once per frame; single player only)\n")	\
 	VERB("  -hogdir <s>                   set shared data directory to <s>\n")	\
 	DXX_COMMAND_LINE_HELP_unix(	\
 		VERB("  -nohogdir                     don't try to use shared data directory\n")	\
@@ -183,9 +184,13 @@ static void print_commandline_help()
 	VERB("  -add-missions-dir <s>         Add contents of location <s> to the missions directory\n")	\
 	VERB("  -use_players_dir              Put player files and saved games in Players subdirectory\n")	\
 	VERB("  -lowmem                       Lowers animation detail for better performance with\n\t\t\t\tlow memory\n")	\
+	VERB("  -object-headroom <n>          Allow <n> objects beyond those placed in the level\n\t\t\t\t(default: 400, single player only)\n")	\
+	VERB("  -worker-threads <n>           Use <n> threads for parallel game logic\n\t\t\t\t(default: 0, use one per CPU core)\n")	\
 	VERB("  -pilot <s>                    Select pilot <s> automatically\n")	\
 	VERB("  -auto-record-demo             Start recording on level entry\n")	\
 	VERB("  -record-demo-format           Set demo name automatically\n")	\
+	VERB("  -demoanalyze <s>              Write per-frame player statistics of demo <s>\n\t\t\t\tto a .csv file beside it, then exit\n")	\
+	VERB("  -demo-capture <n>             Play demos at exactly <n> frames per second and\n\t\t\t\tsave each frame to " SCRNS_DIR "demo-capture.rgb\n")	\
 	VERB("  -autodemo                     Start in demo mode\n")	\
 	VERB("  -window                       Run the game in a window\n")	\
 	VERB("  -noborders                    Don't show borders in window mode\n")	\
@@ -224,6 +229,8 @@ static void print_commandline_help()
 		VERB("                                    5: Auto: if VSync is enabled and ARB_sync is supported, use mode 2, otherwise mode 0\n")	\
 		VERB("  -gl_syncwait <n>              Wait interval (ms) for sync mode 2 (default: " DXX_STRINGIZE(OGL_SYNC_WAIT_DEFAULT) ")\n")	\
 		VERB("  -gl_darkedges                 Re-enable dark edges around filtered textures (as present in earlier versions of the engine)\n")	\
+		VERB("  -gl_levelvbo                  Draw level geometry from static vertex buffers (experimental)\n")	\
+		VERB("  -gl_hudatlas                  Pack HUD gauge bitmaps into shared textures\n")	\
 		DXX_if_defined_01(DXX_USE_STEREOSCOPIC_RENDER, (	\
 		VERB("  -gl_stereo                    Enable OpenGL stereo quad buffering, if available\n")	\
 		VERB("  -gl_stereoview <n>            Select OpenGL stereo viewport mode (experimental; incomplete)\n")	\
@@ -646,7 +653,8 @@ static int main(int argc, char *argv[])
 	 */
 	(void)loaded_builtin_movies;
 
-	show_titles();
+	if (CGameArg.SysAnalyzeDemos.empty())
+		show_titles();
 
 	set_screen_mode(SCREEN_MENU);
 #if DXX_USE_DEBUG_MEMORY_ALLOCATOR
@@ -732,6 +740,15 @@ static int main(int argc, char *argv[])
 		}
 	}
 
+	if (!CGameArg.SysAnalyzeDemos.empty())
+	{
+		/* Analysis runs instead of the menus, so that a script can process
+		 * a batch of demos by starting one instance per demo.
+		 */
+		for (auto &i : CGameArg.SysAnalyzeDemos)
+			newdemo_analyze(i.c_str());
+	}
+	else
 #if DXX_BUILD_DESCENT == 2
 #if DXX_USE_EDITOR
 	if (!GameArg.EdiAutoLoad.empty()) {
@@ -1180,10 +1180,27 @@ imobjptridx_t find_homing_object_complete(const vms_vector &curpos, const vmobjp
 		HOMING_MIN_TRACKABLE_DOT
 	};
 
+	/* Candidates are measured from `curpos`, but visibility is tested
+	 * from the tracker, so widen the search by the distance between
+	 * them.  Visit the candidates in object number order, as a scan of
+	 * every object would, so that ties resolve the same way.
+	 */
+	const fix max_trackable_radius{
+#if DXX_BUILD_DESCENT == 2
+		(tracker_id == weapon_id_type::OMEGA_ID)
+		? fix{OMEGA_MAX_TRACKABLE_DIST}
+		:
+#endif
+		static_cast<fix>(HOMING_MAX_TRACKABLE_DIST)
+	};
+	nearby_object_buffer candidates;
+	find_objects_near(candidates, vcsegptridx(tracker->segnum), tracker->pos, vm_distance{max_trackable_radius + vm_vec_dist(curpos, tracker->pos) + F1_0}, nearby_object_order::objnum);
+
 	imobjptridx_t best_objnum{object_none};
 	fix	max_dot{-F1_0 * 2};
-	range_for (const auto &&curobjp, vmobjptridx)
+	for (const auto &candidate : candidates)
 	{
+		const auto &&curobjp{vmobjptridx(candidate.objnum)};
 		int is_proximity{0};
 
 		if ((curobjp->type != track_obj_type1) && (curobjp->type != track_obj_type2))
@@ -2170,8 +2187,15 @@ static void create_smart_children(object_array &Objects, const vmobjptridx_t obj
 		if (+(Game_mode & GM_MULTI))
 			d_srand(8321L);
 
-		range_for (const auto &&curobjp, vcobjptridx)
+		/* Candidates are visited in object number order, as a scan of
+		 * every object would, so that all game instances build the
+		 * same list.
+		 */
+		nearby_object_buffer candidates;
+		find_objects_near(candidates, vcsegptridx(objp->segnum), objp->pos, MAX_SMART_DISTANCE, nearby_object_order::objnum);
+		for (const auto &candidate : candidates)
 		{
+			const auto &&curobjp{vcobjptridx(candidate.objnum)};
 			if (((curobjp->type == object_type::OBJ_ROBOT && !curobjp->ctype.ai_info.CLOAKED) || curobjp->type == object_type::OBJ_PLAYER) && curobjp != parent.num)
 			{
 				if (curobjp->type == object_type::OBJ_PLAYER)
@@ -55,6 +55,9 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "movie.h"
 #endif
 #include "null_sentinel_iterator.h"
+#if DXX_USE_SDLMIXER
+#include "digi_mixer_music.h"
+#endif
 
 #include "compiler-cf_assert.h"
 #include "compiler-poison.h"
@@ -794,6 +797,10 @@ static std::size_t promote(mission_list_type &mission_list, const char *const na
 
 Mission::~Mission()
 {
+#if DXX_USE_SDLMIXER
+	/* The next mission may supply songs with the same names. */
+	mix_clear_music_cache();
+#endif
     // May become more complex with the editor
 	if (!path.empty() && builtin_hogsize == descent_hog_size::None)
 		{
@@ -477,7 +477,7 @@ objnum_t objnum_remote_to_local(const uint16_t remote_objnum, const int8_t owner
 		return(remote_objnum);
 	}
 
-	if (remote_objnum >= MAX_OBJECTS)
+	if (remote_objnum >= LEGACY_MAX_OBJECTS)
 		return(object_none);
 
 	auto result = remote_to_local[owner][remote_objnum];
@@ -499,7 +499,7 @@ owned_remote_objnum objnum_local_to_remote(objnum_t local_objnum)
 	const char *emsg;
 	if (
 		((owner >= N_players || owner < -1) && (emsg = "illegal object owner", true)) ||
-		(result >= MAX_OBJECTS && (emsg = "illegal object remote number", true))	// See Rob, object has no remote number!
+		(result >= LEGACY_MAX_OBJECTS && (emsg = "illegal object remote number", true))	// See Rob, object has no remote number!
 	)
 		throw std::runtime_error(emsg);
 	return {owner, result};
@@ -510,7 +510,7 @@ void map_objnum_local_to_remote(const objnum_t local_objnum, const int remote_ob
 	// Add a mapping from a network remote object number to a local one
 	Assert(local_objnum < MAX_OBJECTS);
 	Assert(remote_objnum > -1);
-	Assert(remote_objnum < MAX_OBJECTS);
+	Assert(remote_objnum < LEGACY_MAX_OBJECTS);
 	Assert(owner > -1);
 	Assert(owner != Player_num);
 
@@ -1232,7 +1232,7 @@ void multi_do_boss_create_robot(const playernum_t pnum, const multiplayer_rspan<
 		return;
 	}
 	// Do some validity checking
-	if (b.objrobot >= MAX_OBJECTS)
+	if (b.objrobot >= LEGACY_MAX_OBJECTS)
 	{
 		Int3(); // See Rob, bad data in boss gate action message
 		return;
@@ -1379,7 +1379,7 @@ void multi_robot_request_change(const vmobjptridx_t robot, int player_num)
 		return;
 	const auto &&rcrobot = robot.absolute_sibling(robot_controlled[slot]);
 	const auto remote_objnum = objnum_local_to_remote(robot).objnum;
-	if (remote_objnum >= MAX_OBJECTS)
+	if (remote_objnum >= LEGACY_MAX_OBJECTS)
 		return;
 
 	if ( (robot_agitation[slot] < 70) || (MULTI_ROBOT_PRIORITY(remote_objnum, player_num) > MULTI_ROBOT_PRIORITY(remote_objnum, Player_num)) || (d_rand() > 0x4400))
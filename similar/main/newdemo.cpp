@@ -85,7 +85,14 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "d_construct.h"
 #include "d_levelstate.h"
 #include "partial_range.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #define ND_EVENT_EOF				0	// EOF
 #define ND_EVENT_START_DEMO			1	// Followed by 16 character, NULL terminated filename of .SAV file to use
@@ -198,6 +205,10 @@ static sbyte nd_playback_v_bad_read;
 static int nd_playback_v_framecount;
 static fix nd_playback_total, nd_recorded_total, nd_recorded_time;
 static sbyte nd_playback_v_style;
+/* Set while newdemo_analyze reads a demo, so that errors are reported to
+ * the console instead of a dialog that nobody is watching.
+ */
+static bool nd_playback_v_analyzing;
 static ubyte nd_playback_v_dead = 0, nd_playback_v_rear = 0;
 #if DXX_BUILD_DESCENT == 2
 static ubyte nd_playback_v_guided = 0;
@@ -242,7 +253,7 @@ int newdemo_get_percent_done()	{
 		return (PHYSFS_tell(infile) * 100) / nd_playback_v_demosize;
 	}
 	if ( Newdemo_state == ND_STATE_RECORDING ) {
-		return PHYSFS_tell(outfile);
+		return Newdemo_num_written;
 	}
 	return 0;
 }
@@ -296,15 +307,44 @@ static int newdemo_read(std::integral auto *const buffer, const std::size_t elsi
 
 namespace dsx {
 
+namespace {
+
+/* Playback looks up objects by their recorded signature for every linked
+ * sound, every frame.  Every object that playback creates gets its
+ * signature in nd_read_object, which records the object number here, so a
+ * lookup only needs to confirm that the recorded object still carries that
+ * signature.  An entry that no longer matches means that no such object
+ * exists, so stale entries never need to be cleared.
+ */
+std::array<objnum_t, 1u << 16> nd_playback_signature_objnum;
+
+bool nd_object_has_signature(const object_base &obj, const object_signature_t signature)
+{
+	return obj.type != object_type::OBJ_NONE && obj.signature == signature;
+}
+
+void nd_index_object_signature(const vcobjptridx_t obj)
+{
+	auto &Objects = LevelUniqueObjectState.Objects;
+	const auto signature = obj->signature;
+	auto &slot = nd_playback_signature_objnum[static_cast<uint16_t>(signature)];
+	/* Signatures recorded in a demo are truncated, so two live objects may
+	 * share one.  Keep the lower object number, which is the one that a
+	 * scan of the object array would find first.
+	 */
+	if (slot < obj.get_unchecked_index() && nd_object_has_signature(*Objects.vcptr(slot), signature))
+		return;
+	slot = obj;
+}
+
+}
+
 icobjptridx_t newdemo_find_object(object_signature_t signature)
 {
 	auto &Objects = LevelUniqueObjectState.Objects;
-	auto &vcobjptridx = Objects.vcptridx;
-	range_for (const auto &&objp, vcobjptridx)
-	{
-		if ( (objp->type != object_type::OBJ_NONE) && (objp->signature == signature))
-			return objp;
-	}
+	const auto &&objp = Objects.vcptridx(nd_playback_signature_objnum[static_cast<uint16_t>(signature)]);
+	if (nd_object_has_signature(objp, signature))
+		return objp;
 	return object_none;
 }
 
@@ -312,9 +352,109 @@ icobjptridx_t newdemo_find_object(object_signature_t signature)
 
 namespace {
 
+/* Recording produces hundreds of small values per frame.  Collect them in
+ * memory and hand each block to a background thread once it is large
+ * enough, so that the game thread never waits on the filesystem.
+ */
+constexpr std::size_t nd_write_block_size{64 * 1024};
+
+class nd_block_writer
+{
+	std::mutex mutex;
+	std::condition_variable block_ready;
+	std::thread thread;
+	std::deque<std::vector<uint8_t>> pending;
+	PHYSFS_File *file{};
+	bool stopping{};
+	/* Set by the writer thread when a block could not be written in full.
+	 * Read by the game thread on every write, so that recording stops at
+	 * the next opportunity.
+	 */
+	std::atomic<bool> failed{};
+	void writer_main();
+public:
+	std::vector<uint8_t> block;
+	~nd_block_writer()
+	{
+		finish();
+	}
+	void start(PHYSFS_File *f);
+	void queue_block();
+	/* Write every pending block and stop the writer thread.  Returns false
+	 * if any block could not be written.
+	 */
+	bool finish();
+	bool has_failed() const
+	{
+		return failed.load(std::memory_order_relaxed);
+	}
+};
+
+void nd_block_writer::writer_main()
+{
+	for (;;)
+	{
+		std::vector<uint8_t> b;
+		{
+			std::unique_lock lock(mutex);
+			block_ready.wait(lock, [this] { return stopping || !pending.empty(); });
+			if (pending.empty())
+				return;
+			b = std::move(pending.front());
+			pending.pop_front();
+		}
+		if (has_failed())
+			continue;
+		if (PHYSFS_writeBytes(file, b.data(), b.size()) != static_cast<PHYSFS_sint64>(b.size()))
+			failed.store(true, std::memory_order_relaxed);
+	}
+}
+
+void nd_block_writer::start(PHYSFS_File *const f)
+{
+	finish();
+	file = f;
+	failed.store(false, std::memory_order_relaxed);
+	block.clear();
+	block.reserve(nd_write_block_size);
+	thread = std::thread(&nd_block_writer::writer_main, this);
+}
+
+void nd_block_writer::queue_block()
+{
+	if (block.empty())
+		return;
+	{
+		std::lock_guard lock(mutex);
+		pending.emplace_back(std::move(block));
+	}
+	block_ready.notify_one();
+	block = {};
+	block.reserve(nd_write_block_size);
+}
+
+bool nd_block_writer::finish()
+{
+	if (!thread.joinable())
+		return !has_failed();
+	queue_block();
+	{
+		std::lock_guard lock(mutex);
+		stopping = true;
+	}
+	block_ready.notify_one();
+	thread.join();
+	stopping = false;
+	file = nullptr;
+	block = {};
+	return !has_failed();
+}
+
+static nd_block_writer Nd_block_writer;
+
 static int _newdemo_write(const void *buffer, int elsize, int nelem )
 {
-	int num_written, total_size;
+	int total_size;
 
 	if (unlikely(nd_record_v_no_space))
 		return -1;
@@ -323,10 +463,15 @@ static int _newdemo_write(const void *buffer, int elsize, int nelem )
 	nd_record_v_framebytes_written += total_size;
 	Newdemo_num_written += total_size;
 	Assert(outfile);
-	num_written = (PHYSFS_writeBytes)(outfile, buffer, elsize * nelem);
-
-	if (likely(num_written == nelem))
-		return num_written;
+	if (likely(!Nd_block_writer.has_failed()))
+	{
+		auto &block = Nd_block_writer.block;
+		const auto b = static_cast<const uint8_t *>(buffer);
+		block.insert(block.end(), b, b + total_size);
+		if (block.size() >= nd_write_block_size)
+			Nd_block_writer.queue_block();
+		return total_size;
+	}
 
 	nd_record_v_no_space=2;
 	newdemo_stop_recording();
@@ -601,13 +746,17 @@ static void nd_read_object(const vmobjptridx_t obj)
 		obj->type = build_valid_object_type_from_untrusted({t});
 	}
 	if (obj->render_type == render_type::RT_NONE && obj->type != object_type::OBJ_CAMERA)
+	{
+		nd_index_object_signature(obj);
 		return;
+	}
 
 	nd_read_byte(&obj->id);
 	nd_read_byte(&obj->flags);
 	nd_read_short(&shortsig);
 	// It's OKAY! We made sure, obj->signature is never has a value which short cannot handle!!! We cannot do this otherwise, without breaking the demo format!
 	obj->signature = object_signature_t{static_cast<uint16_t>(shortsig)};
+	nd_index_object_signature(obj);
 	nd_read_shortpos(obj);
 
 #if DXX_BUILD_DESCENT == 2
@@ -1723,6 +1872,23 @@ enum class purpose_type : uint8_t
 	rewrite
 };
 
+/* Report why a demo cannot be played.  While analyzing, the message goes
+ * to the console, and the caller abandons the file.
+ */
+static void nd_report_playback_error(const char *fmt, ...) dxx_compiler_attribute_format_printf(1, 2);
+static void nd_report_playback_error(const char *const fmt, ...)
+{
+	std::array<char, 256> message;
+	va_list args;
+	va_start(args, fmt);
+	vsnprintf(message.data(), message.size(), fmt, args);
+	va_end(args);
+	if (nd_playback_v_analyzing)
+		con_puts(CON_URGENT, std::span<const char>(message.data(), strlen(message.data())));
+	else
+		nm_messagebox_str(menu_title{nullptr}, nm_messagebox_tie(TXT_OK), menu_subtitle{message.data()});
+}
+
 namespace dsx {
 
 static int newdemo_read_demo_start(const purpose_type purpose)
@@ -1745,7 +1911,7 @@ static int newdemo_read_demo_start(const purpose_type purpose)
 	if (purpose == purpose_type::rewrite)
 		nd_write_byte(c);
 	if ((c != ND_EVENT_START_DEMO) || nd_playback_v_bad_read) {
-		nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_CORRUPT);
+		nd_report_playback_error("%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_CORRUPT);
 		return 1;
 	}
 	nd_read_byte(&version);
@@ -1757,7 +1923,7 @@ static int newdemo_read_demo_start(const purpose_type purpose)
 	else if (version < DEMO_VERSION) {
 		if (purpose == purpose_type::chose_play)
 		{
-			nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_OLD);
+			nd_report_playback_error("%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_OLD);
 		}
 		return 1;
 	}
@@ -1769,23 +1935,23 @@ static int newdemo_read_demo_start(const purpose_type purpose)
 	if ((game_type == DEMO_GAME_TYPE_SHAREWARE) && shareware)
 		;	// all good
 	else if (game_type != DEMO_GAME_TYPE) {
-		nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_OLD);
+		nd_report_playback_error("%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_OLD);
 
 		return 1;
 	}
 #elif DXX_BUILD_DESCENT == 2
 	if (game_type < DEMO_GAME_TYPE) {
-		nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s %s\n%s", TXT_CANT_PLAYBACK, TXT_RECORDED, "    In Descent: First Strike");
+		nd_report_playback_error("%s %s\n%s", TXT_CANT_PLAYBACK, TXT_RECORDED, "    In Descent: First Strike");
 		return 1;
 	}
 	if (game_type != DEMO_GAME_TYPE) {
-		nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s %s\n%s", TXT_CANT_PLAYBACK, TXT_RECORDED, "   In Unknown Descent version");
+		nd_report_playback_error("%s %s\n%s", TXT_CANT_PLAYBACK, TXT_RECORDED, "   In Unknown Descent version");
 		return 1;
 	}
 	if (version < DEMO_VERSION) {
 		if (purpose == purpose_type::chose_play)
 		{
-			nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_OLD);
+			nd_report_playback_error("%s %s", TXT_CANT_PLAYBACK, TXT_DEMO_OLD);
 		}
 		return 1;
 	}
@@ -1946,7 +2112,7 @@ static int newdemo_read_demo_start(const purpose_type purpose)
 		{
 			if (purpose == purpose_type::chose_play)
 			{
-				nm_messagebox(menu_title{nullptr}, {TXT_OK}, TXT_NOMISSION4DEMO, current_mission);
+				nd_report_playback_error(TXT_NOMISSION4DEMO, current_mission);
 			}
 			return 1;
 		}
@@ -1960,7 +2126,7 @@ static int newdemo_read_demo_start(const purpose_type purpose)
 		{
 		if (purpose != purpose_type::random_play)
 		{
-			nm_messagebox(menu_title{nullptr}, {TXT_OK}, TXT_NOMISSION4DEMO, current_mission);
+			nd_report_playback_error(TXT_NOMISSION4DEMO, current_mission);
 		}
 		return 1;
 		}
@@ -2078,6 +2244,150 @@ static void newdemo_pop_ctrlcen_triggers()
 }
 
 namespace dsx {
+
+namespace {
+
+/* Snapshots of the playback state, taken every ND_SEEK_KEYFRAME_INTERVAL
+ * frames as the demo is played forward, so that a seek only has to replay
+ * the frames after the nearest snapshot.  Every frame records all of the
+ * objects it shows, but wall, texture and player changes are recorded as
+ * events relative to the previous frame, so the snapshot holds those.
+ * Doors and cloaking walls that are still moving are held as well, since
+ * wall_frame_process keeps animating them during playback.
+ *
+ * As with fast forward and rewind, the playback and recorded time totals
+ * are left alone, so that interpolation continues from the seek point.
+ *
+ * Each snapshot is taken just before a frame is read, so restoring one
+ * must be followed by reading at least one frame.
+ */
+constexpr int ND_SEEK_KEYFRAME_INTERVAL{900};
+
+struct nd_seek_wall_side
+{
+	per_side_relative_vertnum_array<uvl> uvls;
+};
+
+struct nd_seek_keyframe
+{
+	PHYSFS_sint64 offset;
+	int framecount;
+	int level;
+	sbyte cntrlcen_destroyed;
+	ubyte dead, rear;
+#if DXX_BUILD_DESCENT == 2
+	ubyte guided;
+#endif
+	std::vector<object> objects;
+	std::vector<player> players;
+	std::vector<wall> walls;
+	std::vector<active_door> active_doors;
+#if DXX_BUILD_DESCENT == 2
+	std::vector<cloaking_wall> cloaking_walls;
+#endif
+	/* The lighting of the side each wall is on, which cloaking walls
+	 * change.
+	 */
+	std::vector<nd_seek_wall_side> wall_sides;
+	std::vector<std::pair<texture1_value, texture2_value>> side_tmaps;
+};
+
+static std::vector<nd_seek_keyframe> Nd_seek_keyframes;
+
+static void nd_save_seek_keyframe()
+{
+	auto &k = Nd_seek_keyframes;
+	const auto framecount{nd_playback_v_framecount};
+	if (framecount < (k.empty() ? 0 : k.back().framecount) + ND_SEEK_KEYFRAME_INTERVAL)
+		return;
+	auto &Objects = LevelUniqueObjectState.Objects;
+	auto &Walls = LevelUniqueWallSubsystemState.Walls;
+	auto &kf = k.emplace_back();
+	kf.offset = PHYSFS_tell(infile);
+	kf.framecount = framecount;
+	kf.level = Current_level_num;
+	kf.cntrlcen_destroyed = nd_playback_v_cntrlcen_destroyed;
+	kf.dead = nd_playback_v_dead;
+	kf.rear = nd_playback_v_rear;
+#if DXX_BUILD_DESCENT == 2
+	kf.guided = nd_playback_v_guided;
+#endif
+	kf.objects.assign(Objects.begin(), Objects.begin() + Objects.get_count());
+	kf.players.assign(Players.begin(), Players.end());
+	kf.walls.assign(Walls.begin(), Walls.begin() + Walls.get_count());
+	auto &ActiveDoors = LevelUniqueWallSubsystemState.ActiveDoors;
+	kf.active_doors.assign(ActiveDoors.begin(), ActiveDoors.begin() + ActiveDoors.get_count());
+#if DXX_BUILD_DESCENT == 2
+	auto &CloakingWalls = LevelUniqueWallSubsystemState.CloakingWalls;
+	kf.cloaking_walls.assign(CloakingWalls.begin(), CloakingWalls.begin() + CloakingWalls.get_count());
+#endif
+	kf.wall_sides.reserve(kf.walls.size());
+	for (auto &w : kf.walls)
+		kf.wall_sides.push_back({vcsegptr(w.segnum)->unique_segment::sides[w.sidenum].uvls});
+	kf.side_tmaps.reserve((Highest_segment_index + 1) * static_cast<std::size_t>(MAX_SIDES_PER_SEGMENT.value));
+	for (const unique_segment &useg : vcsegptr)
+		for (auto &side : useg.sides)
+			kf.side_tmaps.emplace_back(side.tmap_num, side.tmap_num2);
+}
+
+/* Return the last snapshot at or before `framecount`, or nullptr if there
+ * is none.
+ */
+static const nd_seek_keyframe *nd_find_seek_keyframe(const int framecount)
+{
+	auto &k = Nd_seek_keyframes;
+	const auto i{std::upper_bound(k.begin(), k.end(), framecount, [](const int f, const nd_seek_keyframe &kf) { return f < kf.framecount; })};
+	return i == k.begin() ? nullptr : &*std::prev(i);
+}
+
+static void nd_restore_seek_keyframe(const nd_seek_keyframe &kf)
+{
+	auto &Objects = LevelUniqueObjectState.Objects;
+	auto &Walls = LevelUniqueWallSubsystemState.Walls;
+	if (kf.level != Current_level_num)
+	{
+#if DXX_BUILD_DESCENT == 2
+		load_level_robots(kf.level);
+#endif
+		LoadLevel(kf.level, 1);
+	}
+	PHYSFS_seek(infile, kf.offset);
+	nd_playback_v_framecount = kf.framecount;
+	nd_playback_v_at_eof = 0;
+	nd_playback_v_cntrlcen_destroyed = kf.cntrlcen_destroyed;
+	nd_playback_v_dead = kf.dead;
+	nd_playback_v_rear = kf.rear;
+#if DXX_BUILD_DESCENT == 2
+	nd_playback_v_guided = kf.guided;
+#endif
+	std::copy(kf.objects.begin(), kf.objects.end(), Objects.begin());
+	Objects.set_count(kf.objects.size());
+	std::copy(kf.players.begin(), kf.players.end(), Players.begin());
+	Walls.set_count(kf.walls.size());
+	std::copy(kf.walls.begin(), kf.walls.end(), Walls.begin());
+	auto &ActiveDoors = LevelUniqueWallSubsystemState.ActiveDoors;
+	ActiveDoors.set_count(kf.active_doors.size());
+	std::copy(kf.active_doors.begin(), kf.active_doors.end(), ActiveDoors.begin());
+#if DXX_BUILD_DESCENT == 2
+	auto &CloakingWalls = LevelUniqueWallSubsystemState.CloakingWalls;
+	CloakingWalls.set_count(kf.cloaking_walls.size());
+	std::copy(kf.cloaking_walls.begin(), kf.cloaking_walls.end(), CloakingWalls.begin());
+#endif
+	auto ws{kf.wall_sides.begin()};
+	for (auto &w : kf.walls)
+		vmsegptr(w.segnum)->unique_segment::sides[w.sidenum].uvls = (ws++)->uvls;
+	auto st{kf.side_tmaps.begin()};
+	for (unique_segment &useg : vmsegptr)
+		for (auto &side : useg.sides)
+		{
+			side.tmap_num = st->first;
+			side.tmap_num2 = st->second;
+			++st;
+		}
+}
+
+}
+
 static int newdemo_read_frame_information(int rewrite)
 {
 	auto &LevelUniqueControlCenterState = LevelUniqueObjectState.ControlCenterState;
@@ -2090,6 +2400,9 @@ static int newdemo_read_frame_information(int rewrite)
 
 	done = 0;
 
+	if (!rewrite && !nd_playback_v_analyzing && (Newdemo_vcr_state == ND_STATE_PLAYBACK || Newdemo_vcr_state == ND_STATE_FASTFORWARD || Newdemo_vcr_state == ND_STATE_ONEFRAMEFORWARD))
+		nd_save_seek_keyframe();
+
 	if (Newdemo_vcr_state != ND_STATE_PAUSED)
 		for (unique_segment &useg : vmsegptr)
 		{
@@ -3300,7 +3613,7 @@ static int newdemo_read_frame_information(int rewrite)
 				}
 				if (loaded_level < Current_mission->last_secret_level || loaded_level > Current_mission->last_level)
 				{
-					nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s\n%s\n%s", TXT_CANT_PLAYBACK, TXT_LEVEL_CANT_LOAD, TXT_DEMO_OLD_CORRUPT);
+					nd_report_playback_error("%s\n%s\n%s", TXT_CANT_PLAYBACK, TXT_LEVEL_CANT_LOAD, TXT_DEMO_OLD_CORRUPT);
 					Current_mission.reset();
 					return -1;
 				}
@@ -3417,7 +3730,7 @@ static int newdemo_read_frame_information(int rewrite)
 	}
 
 	if (nd_playback_v_bad_read) {
-		nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s %s", TXT_DEMO_ERR_READING, TXT_DEMO_OLD_CORRUPT);
+		nd_report_playback_error("%s %s", TXT_DEMO_ERR_READING, TXT_DEMO_OLD_CORRUPT);
 		Current_mission.reset();
 	}
 
@@ -3461,7 +3774,7 @@ window_event_result newdemo_goto_end(int to_rewrite)
 	{
 		if (level < Current_mission->last_secret_level || level > Current_mission->last_level)
 		{
-			nm_messagebox(menu_title{nullptr}, {TXT_OK}, "%s\n%s\n%s", TXT_CANT_PLAYBACK, TXT_LEVEL_CANT_LOAD, TXT_DEMO_OLD_CORRUPT);
+			nd_report_playback_error("%s\n%s\n%s", TXT_CANT_PLAYBACK, TXT_LEVEL_CANT_LOAD, TXT_DEMO_OLD_CORRUPT);
 			Current_mission.reset();
 			newdemo_stop_playback();
 			return window_event_result::close;
@@ -3636,6 +3949,43 @@ static window_event_result newdemo_back_frames(int frames)
 	return window_event_result::handled;
 }
 
+namespace dsx {
+//jump `frames` frames forward, or backward if negative, and pause there.
+//This restores the nearest earlier keyframe, if that is closer than the
+//current frame, and replays from there without rendering.
+window_event_result newdemo_seek_frames(const int frames)
+{
+	const int target{std::max(nd_playback_v_framecount + frames, 0)};
+	const auto kf{nd_find_seek_keyframe(target)};
+	bool read_one{false};
+	if (kf && (target < nd_playback_v_framecount || kf->framecount > nd_playback_v_framecount))
+	{
+		nd_restore_seek_keyframe(*kf);
+		read_one = true;
+	}
+	else if (target < nd_playback_v_framecount)
+	{
+		const auto result{newdemo_goto_beginning()};
+		if (Newdemo_state != ND_STATE_PLAYBACK)
+			return result;
+	}
+	Newdemo_vcr_state = ND_STATE_FASTFORWARD;
+	while (read_one || (nd_playback_v_framecount < target && !nd_playback_v_at_eof))
+	{
+		read_one = false;
+		if (newdemo_read_frame_information(0) == -1)
+		{
+			if (nd_playback_v_at_eof)
+				break;
+			newdemo_stop_playback();
+			return window_event_result::close;
+		}
+	}
+	Newdemo_vcr_state = ND_STATE_PAUSED;
+	return window_event_result::handled;
+}
+}
+
 /*
  *  routine to interpolate the viewer position.  the current position is
  *  stored in the Viewer object.  Save this position, and read the next
@@ -3943,6 +4293,16 @@ window_event_result newdemo_playback_one_frame()
 
 void newdemo_start_recording()
 {
+	/* Demo readers may be older builds, which reject object numbers at or
+	 * above the legacy capacity.  Objects already in those slots cannot be
+	 * renumbered mid-level, since other objects refer to them by number, so
+	 * refuse to record until they are gone.
+	 */
+	if (auto &Objects = LevelUniqueObjectState.Objects; Highest_object_index >= LEGACY_MAX_OBJECTS)
+	{
+		nm_messagebox_str(menu_title{nullptr}, nm_messagebox_tie(TXT_OK), menu_subtitle{"Too many objects in use to record a demo.\nTry again after the battle calms down."});
+		return;
+	}
 	Newdemo_num_written = 0;
 	nd_record_v_no_space=0;
 	Newdemo_state = ND_STATE_RECORDING;
@@ -3973,7 +4333,15 @@ void newdemo_start_recording()
 		run_blocking_newmenu<error_writing_demo>(errstr);
 	}
 	else
+	{
+		/* Every object is below the legacy capacity.  Rebuilding the free
+		 * list lowers the limit so that new objects stay there too.
+		 */
+		if (LevelUniqueObjectState.object_limit > LEGACY_MAX_OBJECTS)
+			special_reset_objects(LevelUniqueObjectState, LevelSharedRobotInfoState.Robot_info);
+		Nd_block_writer.start(outfile);
 		newdemo_record_start_demo();
+	}
 }
 
 static void newdemo_write_end()
@@ -4148,6 +4516,8 @@ void newdemo_stop_recording()
 		newdemo_write_end();
 	}
 
+	if (!Nd_block_writer.finish())
+		nd_record_v_no_space = 2;
 	outfile.reset();
 	Newdemo_state = ND_STATE_NORMAL;
 	gr_palette_load( gr_palette );
@@ -4296,6 +4666,7 @@ void newdemo_start_playback(const char * filename)
 	nd_playback_v_at_eof = 0;
 	nd_playback_v_framecount = 0;
 	nd_playback_v_style = NORMAL_PLAYBACK;
+	Nd_seek_keyframes.clear();
 #if DXX_BUILD_DESCENT == 2
 	init_seismic_disturbances();
 	//turn off 3d views on cockpit
@@ -4319,10 +4690,35 @@ void newdemo_start_playback(const char * filename)
 
 }
 
+namespace {
+
+/* Quote a callsign for the .csv file as RFC 4180 requires, so that a comma
+ * or a quote in it cannot shift the columns after it.
+ */
+static std::array<char, 2 * CALLSIGN_LEN + 3> csv_quote_callsign(const callsign_t &callsign)
+{
+	std::array<char, 2 * CALLSIGN_LEN + 3> result{};
+	auto o{result.begin()};
+	*o++ = '"';
+	for (const char c : callsign.a)
+	{
+		if (!c)
+			break;
+		if (c == '"')
+			*o++ = '"';
+		*o++ = c;
+	}
+	*o = '"';
+	return result;
+}
+
+}
+
 namespace dsx {
 void newdemo_stop_playback()
 {
 	infile.reset();
+	Nd_seek_keyframes = {};
 	Newdemo_state = ND_STATE_NORMAL;
 	change_playernum_to(0);             //this is reality
 	get_local_player().callsign = nd_playback_v_save_callsign;
@@ -4335,6 +4731,110 @@ void newdemo_stop_playback()
 	// Required for the editor
 	obj_relink_all();
 }
+
+/* Read every frame of a demo without drawing it or playing its sounds, and
+ * write the state of each player after every frame to a .csv file beside
+ * the demo.
+ */
+void newdemo_analyze(const char *const filename)
+{
+	auto &Objects = LevelUniqueObjectState.Objects;
+	auto &vcobjptr = Objects.vcptr;
+	auto &vmobjptr = Objects.vmptr;
+	char inpath[PATH_MAX+FILENAME_LEN] = DEMO_DIR;
+	std::array<char, PATH_MAX> csvpath;
+
+	strncat(inpath, filename, sizeof(inpath) - sizeof(DEMO_DIR));
+	if (!change_filename_extension(csvpath, inpath, "CSV"))
+		return;
+	infile = PHYSFSX_openReadBuffered_updateCase(inpath).first;
+	if (!infile)
+	{
+		con_printf(CON_URGENT, "Failed to open demo \"%s\"", inpath);
+		return;
+	}
+	auto csvfile = PHYSFSX_openWriteBuffered(csvpath.data()).first;
+	if (!csvfile)
+	{
+		con_printf(CON_URGENT, "Failed to open \"%s\" for writing", csvpath.data());
+		infile.reset();
+		return;
+	}
+
+	nd_playback_v_bad_read = 0;
+	change_playernum_to(0);
+	nd_playback_v_save_callsign = get_local_player().callsign;
+	Viewer = ConsoleObject = &Objects.front();
+	nd_playback_v_analyzing = true;
+	if (newdemo_read_demo_start(purpose_type::random_play))
+	{
+		con_printf(CON_URGENT, "Failed to read the start of demo \"%s\"", inpath);
+		nd_playback_v_analyzing = false;
+		infile.reset();
+		return;
+	}
+
+	Game_mode = GM_NORMAL;
+	Newdemo_state = ND_STATE_PLAYBACK;
+	/* Fast forward reads every event the same way that normal playback
+	 * does, but never starts a sound.
+	 */
+	Newdemo_vcr_state = ND_STATE_FASTFORWARD;
+	nd_playback_v_demosize = PHYSFS_fileLength(infile);
+	nd_playback_v_at_eof = 0;
+	nd_playback_v_framecount = 0;
+	nd_playback_v_style = NORMAL_PLAYBACK;
+	nd_playback_v_dead = nd_playback_v_rear = 0;
+	/* Only normal playback adds up nd_recorded_total, so count the time
+	 * of each frame here.
+	 */
+	fix64 recorded_total{0};
+
+	PHYSFSX_puts_literal(csvfile, "frame,time,player,callsign,connected,segment,x,y,z,score,kills,deaths,shields,energy\n");
+	int done;
+	while ((done = newdemo_read_frame_information(0)) == 1)
+	{
+		recorded_total += nd_recorded_time;
+		std::array<const object *, MAX_PLAYERS> player_objects{};
+		range_for (const auto &obj, vcobjptr)
+		{
+			if (obj.type == object_type::OBJ_PLAYER && get_player_id(obj) < player_objects.size())
+			{
+				auto &po = player_objects[get_player_id(obj)];
+				if (!po)
+					po = &obj;
+			}
+		}
+		const auto time = static_cast<double>(recorded_total) / F1_0;
+		const unsigned nplayers = +(Newdemo_game_mode & GM_MULTI) ? N_players : 1;
+		for (const unsigned i : xrange(nplayers))
+		{
+			auto &plr = *vcplayerptr(i);
+			auto &player_info = vcobjptr(plr.objnum)->ctype.player_info;
+			PHYSFSX_printf(csvfile, "%i,%.3f,%u,%s,%u,", nd_playback_v_framecount, time, i, csv_quote_callsign(plr.callsign).data(), static_cast<unsigned>(plr.connected));
+			if (const auto po = player_objects[i])
+				PHYSFSX_printf(csvfile, "%hu,%.3f,%.3f,%.3f,", static_cast<segnum_t>(po->segnum), f2fl(po->pos.x), f2fl(po->pos.y), f2fl(po->pos.z));
+			else
+				PHYSFSX_puts_literal(csvfile, ",,,,");
+			PHYSFSX_printf(csvfile, "%i,%i,%i,", player_info.mission.score, player_info.net_kills_total, player_info.net_killed_total);
+			/* Only the player who recorded the demo has shields and
+			 * energy in it.
+			 */
+			if (i == Player_num)
+			{
+				auto &plrobj = get_local_plrobj();
+				PHYSFSX_printf(csvfile, "%.0f,%.0f\n", f2fl(plrobj.shields), f2fl(plrobj.ctype.player_info.energy));
+			}
+			else
+				PHYSFSX_puts_literal(csvfile, ",\n");
+		}
+	}
+	nd_playback_v_analyzing = false;
+	if (done == -1 && !nd_playback_v_at_eof)
+		con_printf(CON_URGENT, "Stopped reading demo \"%s\" at frame %i after an error", inpath, nd_playback_v_framecount);
+	con_printf(CON_NORMAL, "Wrote statistics for %i frames of demo \"%s\" to \"%s\"", nd_playback_v_framecount, inpath, csvpath.data());
+	newdemo_stop_playback();
+}
 }
 
 
@@ -4360,6 +4860,7 @@ int newdemo_swap_endian(const char *filename)
 		goto read_error;
 	}
 
+	Nd_block_writer.start(outfile);
 	Newdemo_num_written = 0;
 	nd_playback_v_bad_read = 0;
 	swap_endian = 1;
@@ -4369,6 +4870,7 @@ int newdemo_swap_endian(const char *filename)
 	if (newdemo_read_demo_start(purpose_type::rewrite))
 	{
 		infile.reset();
+		Nd_block_writer.finish();
 		outfile.reset();
 		swap_endian = 0;
 		return 0;
@@ -4380,7 +4882,7 @@ int newdemo_swap_endian(const char *filename)
 	newdemo_write_end();	// and write it
 
 	swap_endian = 0;
-	complete = nd_playback_v_demosize == Newdemo_num_written;
+	complete = Nd_block_writer.finish() && nd_playback_v_demosize == Newdemo_num_written;
 	infile.reset();
 	outfile.reset();
 
@@ -71,6 +71,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "gameseq.h"
 #include "playsave.h"
 #include "timer.h"
+#include "args.h"
 #if DXX_USE_EDITOR
 #include "editor/editor.h"
 #endif
@@ -81,6 +82,7 @@ COPYRIGHT 1993-1999 PARALLAX SOFTWARE CORPORATION.  ALL RIGHTS RESERVED.
 #include "d_levelstate.h"
 #include "d_underlying_value.h"
 #include "partial_range.h"
+#include "segiter.h"
 #include <utility>
 
 using std::min;
@@ -1004,6 +1006,54 @@ void init_player_object(const d_level_shared_polygon_model_state &LevelSharedPol
 	reset_player_object(console);
 }
 
+namespace {
+
+/* Choose how many object slots may be allocated, given that
+ * `level_objects` slots are in use when the free list is rebuilt.
+ */
+static unsigned build_object_limit(const unsigned level_objects)
+{
+	/* Multiplayer peers and demo readers may be older builds, which
+	 * reject object numbers at or above the legacy capacity.
+	 */
+	if (+(Game_mode & GM_MULTI) || Newdemo_state != ND_STATE_NORMAL)
+		return LEGACY_MAX_OBJECTS;
+	return std::clamp<unsigned>(level_objects + CGameArg.SysObjectHeadroom, LEGACY_MAX_OBJECTS, MAX_OBJECTS);
+}
+
+}
+
+namespace {
+
+static reclaimable_object_type get_reclaimable_object_type(const object_type type)
+{
+	switch (type)
+	{
+		case object_type::OBJ_DEBRIS:
+			return reclaimable_object_type::debris;
+		case object_type::OBJ_FIREBALL:
+			return reclaimable_object_type::fireball;
+		case object_type::OBJ_WEAPON:
+			return reclaimable_object_type::weapon;
+		default:
+			return reclaimable_object_type::None;
+	}
+}
+
+//rebuild the reclaimable object lists from the allocated slots, in
+//object number order
+static void rebuild_reclaimable_object_lists(d_level_unique_object_state &LevelUniqueObjectState)
+{
+	auto &Objects = LevelUniqueObjectState.get_objects();
+	auto &allocated_objects = LevelUniqueObjectState.allocated_objects;
+	auto &reclaimable_objects = LevelUniqueObjectState.reclaimable_objects;
+	reclaimable_objects.clear();
+	for (std::size_t i = 0, end = Objects.get_count(); (i = allocated_objects.find_next(i, end)) != end; ++i)
+		reclaimable_objects.push_back(i, get_reclaimable_object_type(Objects.vcptr(static_cast<objnum_t>(i))->type));
+}
+
+}
+
 //sets up the free list & init player & whatever else
 void init_objects()
 {
@@ -1025,6 +1075,10 @@ void init_objects()
 	init_player_object(LevelSharedPolygonModelState, *ConsoleObject);
 	obj_link_unchecked(Objects.vmptr, Objects.vmptridx(ConsoleObject), Segments.vmptridx(segment_first));	//put in the world in segment 0
 	LevelUniqueObjectState.num_objects = 1;						//just the player
+	LevelUniqueObjectState.object_limit = build_object_limit(1);
+	LevelUniqueObjectState.allocated_objects.clear();
+	LevelUniqueObjectState.allocated_objects.set(0);
+	LevelUniqueObjectState.reclaimable_objects.clear();
 	Objects.set_count(1);
 }
 
@@ -1040,6 +1094,8 @@ void special_reset_objects(d_level_unique_object_state &LevelUniqueObjectState,
 	assert(Objects.front().type != object_type::OBJ_NONE);		//0 should be used
 
 	DXX_POISON_VAR(LevelUniqueObjectState.free_obj_list, 0xfd);
+	auto &allocated_objects = LevelUniqueObjectState.allocated_objects;
+	allocated_objects.clear();
 #if DXX_BUILD_DESCENT == 1
 	/* Descent 1 does not have a guidebot, so there is nothing to fix up.  For
 	 * simplicity, both games pass the parameter.
@@ -1062,13 +1118,18 @@ void special_reset_objects(d_level_unique_object_state &LevelUniqueObjectState,
 		if (obj.type == object_type::OBJ_NONE)
 			LevelUniqueObjectState.free_obj_list[--num_objects] = i;
 		else
+		{
+			allocated_objects.set(i);
 			if (i > Highest_object_index)
 				Objects.set_count(i + 1);
+		}
 	}
 #if DXX_BUILD_DESCENT == 2
 	LevelUniqueObjectState.BuddyState.Buddy_objnum = Buddy_objnum;
 #endif
 	LevelUniqueObjectState.num_objects = num_objects;
+	LevelUniqueObjectState.object_limit = build_object_limit(std::max<unsigned>(num_objects, Objects.get_count()));
+	rebuild_reclaimable_object_lists(LevelUniqueObjectState);
 }
 
 void obj_link_unchecked(fvmobjptr &vmobjptr, const vmobjptridx_t obj, const vmsegptridx_t segnum)
@@ -1121,10 +1182,11 @@ void obj_unlink(fvmobjptr &vmobjptr, fvmsegptr &vmsegptr, object_base &obj)
 imobjptridx_t obj_allocate(d_level_unique_object_state &LevelUniqueObjectState)
 {
 	auto &Objects = LevelUniqueObjectState.Objects;
-	if (LevelUniqueObjectState.num_objects >= Objects.size())
+	if (LevelUniqueObjectState.num_objects >= LevelUniqueObjectState.object_limit)
 		return object_none;
 
 	const auto objnum = LevelUniqueObjectState.free_obj_list[LevelUniqueObjectState.num_objects++];
+	LevelUniqueObjectState.allocated_objects.set(objnum);
 	if (objnum >= Objects.get_count())
 	{
 		Objects.set_count(objnum + 1);
@@ -1144,92 +1206,47 @@ static void obj_free(d_level_unique_object_state &LevelUniqueObjectState, const
 	const auto num_objects = -- LevelUniqueObjectState.num_objects;
 	assert(num_objects < LevelUniqueObjectState.free_obj_list.size());
 	LevelUniqueObjectState.free_obj_list[num_objects] = objnum;
+	auto &allocated_objects = LevelUniqueObjectState.allocated_objects;
+	allocated_objects.reset(objnum);
+	LevelUniqueObjectState.reclaimable_objects.remove(objnum);
 	auto &Objects = LevelUniqueObjectState.get_objects();
 
-	objnum_t o = objnum;
-	if (o == Highest_object_index)
+	if (const objnum_t o = objnum; o == Highest_object_index)
 	{
-		for (;;)
-		{
-			--o;
-			if (Objects.vcptr(o)->type != object_type::OBJ_NONE)
-				break;
-			if (o == 0)
-				break;
-		}
-		Objects.set_count(o + 1);
+		/* Slot 0 is the lowest value the count may shrink to, even if
+		 * that slot is free.
+		 */
+		const auto last{allocated_objects.find_last(o)};
+		Objects.set_count(last == o ? 1 : last + 1);
 	}
 }
 
 //-----------------------------------------------------------------------------
-//	Scan the object list, freeing down to num_used objects
-//	Returns number of slots freed.
-static void free_object_slots(uint_fast32_t num_used)
-{
-	auto &Objects = LevelUniqueObjectState.Objects;
-	auto &vmobjptr = Objects.vmptr;
-	std::array<object *, MAX_OBJECTS>	obj_list;
-	unsigned	num_already_free, num_to_free, olind = 0;
-
-	num_already_free = MAX_OBJECTS - Highest_object_index - 1;
-
-	if (MAX_OBJECTS - num_already_free < num_used)
+//	Delete debris, fireballs, flares and then other weapons, oldest first,
+//	until no more than num_used slots are in use.  This must run after
+//	objects that should be dead have been deleted, so that every allocated
+//	slot holds a live object.
+static void free_object_slots(d_level_unique_object_state &LevelUniqueObjectState, const unsigned num_used)
+{
+	const unsigned num_objects{LevelUniqueObjectState.num_objects};
+	if (num_objects <= num_used)
 		return;
-
-	for (auto &obj : vmobjptr)
-	{
-		if (obj.flags & OF_SHOULD_BE_DEAD)
-		{
-			num_already_free++;
-			if (MAX_OBJECTS - num_already_free < num_used)
-				return;
-		} else
-			switch (obj.type)
-			{
-				case object_type::OBJ_NONE:
-					num_already_free++;
-					if (MAX_OBJECTS - num_already_free < num_used)
-						return;
-					break;
-				case object_type::OBJ_WALL:
-					Int3();		//	This is curious.  What is an object that is a wall?
-					break;
-				case object_type::OBJ_FIREBALL:
-				case object_type::OBJ_WEAPON:
-				case object_type::OBJ_DEBRIS:
-					obj_list[olind++] = &obj;
-					break;
-				case object_type::OBJ_ROBOT:
-				case object_type::OBJ_HOSTAGE:
-				case object_type::OBJ_PLAYER:
-				case object_type::OBJ_CNTRLCEN:
-				case object_type::OBJ_CLUTTER:
-				case object_type::OBJ_GHOST:
-				case object_type::OBJ_LIGHT:
-				case object_type::OBJ_CAMERA:
-				case object_type::OBJ_POWERUP:
-				case object_type::OBJ_COOP:
-				case object_type::OBJ_MARKER:
-					break;
-			}
-
-	}
-
-	num_to_free = MAX_OBJECTS - num_used - num_already_free;
-
-	if (num_to_free > olind) {
-		num_to_free = olind;
-	}
-
-	// Capture before num_to_free modified
-	const auto &&r = partial_const_range(obj_list, num_to_free);
-	auto l = [&vmobjptr, &r, &num_to_free](const auto predicate) -> bool {
-		range_for (const auto i, r)
+	unsigned num_to_free{num_objects - num_used};
+	auto &Objects = LevelUniqueObjectState.get_objects();
+	auto &reclaimable_objects = LevelUniqueObjectState.reclaimable_objects;
+	/* Collect the victims before deleting any of them, since deleting an
+	 * object unlinks it from the list being walked.
+	 */
+	std::array<objnum_t, MAX_OBJECTS> victims;
+	unsigned num_victims{};
+	auto l = [&](const reclaimable_object_type list, const auto predicate) -> bool {
+		for (auto i{reclaimable_objects.front(list)}; i != reclaimable_objects.end_of_list; i = reclaimable_objects.next(i))
 		{
-			auto &o = *vmobjptr(i);
-			if (predicate(o))
+			auto &o = *Objects.vmptr(i);
+			if (!(o.flags & OF_SHOULD_BE_DEAD) && predicate(o))
 			{
 				o.flags |= OF_SHOULD_BE_DEAD;
+				victims[num_victims++] = i;
 				if (!-- num_to_free)
 					return true;
 			}
@@ -1237,17 +1254,12 @@ static void free_object_slots(uint_fast32_t num_used)
 		return false;
 	};
 
-	if (l(predicate_debris))
-		return;
-
-	if (l(predicate_fireball))
-		return;
-
-	if (l(predicate_flare))
-		return;
-
-	if (l(predicate_nonflare_weapon))
-		return;
+	l(reclaimable_object_type::debris, predicate_debris) ||
+		l(reclaimable_object_type::fireball, predicate_fireball) ||
+		l(reclaimable_object_type::weapon, predicate_flare) ||
+		l(reclaimable_object_type::weapon, predicate_nonflare_weapon);
+	for (const auto i : partial_const_range(victims, num_victims))
+		obj_delete(LevelUniqueObjectState, Segments, Objects.vmptridx(i));
 }
 
 }
@@ -1298,6 +1310,7 @@ imobjptridx_t obj_create(d_level_unique_object_state &LevelUniqueObjectState, co
 
 	obj->signature = next(signature);
 	obj->type 				= type;
+	LevelUniqueObjectState.reclaimable_objects.push_back(obj, get_reclaimable_object_type(type));
 	obj->id 				= id;
 	obj->pos 				= pos;
 	obj->size 				= size;
@@ -1438,6 +1451,8 @@ void obj_delete(d_level_unique_object_state &LevelUniqueObjectState, segment_arr
 
 	if (obj->type == object_type::OBJ_DEBRIS)
 		-- LevelUniqueObjectState.Debris_object_count;
+	else if (obj->type == object_type::OBJ_ROBOT)
+		ai_path_free(obj);
 
 	if (obj->movement_source == object::movement_type::physics && (obj->mtype.phys_info.flags & PF_STICK))
 		LevelUniqueStuckObjectState.remove_stuck_object(obj);
@@ -1776,8 +1791,10 @@ static void obj_delete_all_that_should_be_dead()
 	objnum_t		local_dead_player_object=object_none;
 
 	// Move all objects
-	range_for (const auto &&objp, vmobjptridx)
+	auto &allocated_objects = LevelUniqueObjectState.allocated_objects;
+	for (std::size_t i = 0, end = Objects.get_count(); (i = allocated_objects.find_next(i, end)) != end; ++i)
 	{
+		const auto &&objp = vmobjptridx(static_cast<objnum_t>(i));
 		if ((objp->type!=object_type::OBJ_NONE) && (objp->flags&OF_SHOULD_BE_DEAD) )	{
 			Assert(!(objp->type==object_type::OBJ_FIREBALL && objp->ctype.expl_info.delete_time!=-1));
 			if (objp->type==object_type::OBJ_PLAYER) {
@@ -2210,19 +2227,26 @@ static window_event_result object_move_all(const d_level_shared_robot_info_state
 	auto &vmobjptridx = Objects.vmptridx;
 	auto result = window_event_result::ignored;
 
-	if (Highest_object_index > MAX_USED_OBJECTS)
-		free_object_slots(MAX_USED_OBJECTS);		//	Free all possible object slots.
-
 	obj_delete_all_that_should_be_dead();
 
+	if (const auto object_limit{LevelUniqueObjectState.object_limit}; Highest_object_index > object_limit - RESERVED_FREE_OBJECTS)
+		free_object_slots(LevelUniqueObjectState, object_limit - RESERVED_FREE_OBJECTS);		//	Free all possible object slots.
+
 	if (PlayerCfg.AutoLeveling)
 		ConsoleObject->mtype.phys_info.flags |= PF_LEVELLING;
 	else
 		ConsoleObject->mtype.phys_info.flags &= ~PF_LEVELLING;
 
 	// Move all objects
-	range_for (const auto &&objp, vmobjptridx)
+	/* Walk the allocated-slot bitmap rather than every object, so that
+	 * unused slots cost one bit test instead of a cache miss each.  As
+	 * with iterating `vmobjptridx`, objects created during the loop in a
+	 * slot past the original count are not moved until the next frame.
+	 */
+	auto &allocated_objects = LevelUniqueObjectState.allocated_objects;
+	for (std::size_t i = 0, end = Objects.get_count(); (i = allocated_objects.find_next(i, end)) != end; ++i)
 	{
+		const auto &&objp = vmobjptridx(static_cast<objnum_t>(i));
 		if ( (objp->type != object_type::OBJ_NONE) && (!(objp->flags&OF_SHOULD_BE_DEAD)) )	{
 			result = std::max(object_move_one(LevelSharedRobotInfoState, objp, Controls), result);
 		}
@@ -2320,12 +2344,17 @@ void reset_objects(d_level_unique_object_state &LevelUniqueObjectState, const un
 	assert(LevelUniqueObjectState.num_objects > 0);
 	auto &Objects = LevelUniqueObjectState.get_objects();
 	assert(LevelUniqueObjectState.num_objects < Objects.size());
+	LevelUniqueObjectState.object_limit = build_object_limit(n_objs);
 	Objects.set_count(n_objs);
 #if DXX_BUILD_DESCENT == 2
 	if (LevelUniqueObjectState.BuddyState.Buddy_objnum.get_unchecked_index() >= n_objs)
 		LevelUniqueObjectState.BuddyState.Buddy_objnum = object_none;
 #endif
 
+	auto &allocated_objects = LevelUniqueObjectState.allocated_objects;
+	allocated_objects.clear();
+	for (objnum_t i = 0; i < n_objs; ++i)
+		allocated_objects.set(i);
 	for (objnum_t i = n_objs; i < MAX_OBJECTS; ++i)
 	{
 		LevelUniqueObjectState.free_obj_list[i] = i;
@@ -2334,6 +2363,7 @@ void reset_objects(d_level_unique_object_state &LevelUniqueObjectState, const un
 		obj.type = object_type::OBJ_NONE;
 		obj.signature = object_signature_t{0};
 	}
+	rebuild_reclaimable_object_lists(LevelUniqueObjectState);
 }
 
 //Tries to find a segment for an object, using find_point_seg()
@@ -2837,6 +2867,128 @@ void object_rw_swap(object_rw *obj, const physfsx_endian swap)
 
 }
 
+namespace dsx {
+
+namespace {
+
+struct segment_bounds
+{
+	vms_vector center;
+	fix radius;
+};
+
+/* Bounding sphere of each segment, used by find_objects_near.  Built on
+ * first use after a level is loaded.  The editor can move vertices at
+ * any time, so the cache is not used while the editor is open.
+ */
+static std::vector<segment_bounds> Segment_bounds;
+
+/* Vectors not lent to any nearby_object_buffer.  This only grows when
+ * searches nest more deeply than before.
+ */
+static std::vector<std::vector<nearby_object>> Nearby_object_buffer_pool;
+
+static segment_bounds build_segment_bounds(fvcvertptr &vcvertptr, const shared_segment &seg)
+{
+	const auto center{compute_segment_center(vcvertptr, seg)};
+	fix radius{0};
+	for (const auto v : seg.verts)
+		radius = std::max<fix>(radius, vm_vec_dist(center, vcvertptr(v)));
+	return {center, radius};
+}
+
+}
+
+void invalidate_segment_bounds()
+{
+	Segment_bounds.clear();
+}
+
+nearby_object_buffer::nearby_object_buffer()
+{
+	if (!Nearby_object_buffer_pool.empty())
+	{
+		objects = std::move(Nearby_object_buffer_pool.back());
+		Nearby_object_buffer_pool.pop_back();
+	}
+}
+
+nearby_object_buffer::~nearby_object_buffer()
+{
+	objects.clear();
+	Nearby_object_buffer_pool.push_back(std::move(objects));
+}
+
+void find_objects_near(std::vector<nearby_object> &result, const vcsegptridx_t start_seg, const vms_vector &center, const vm_distance radius, const nearby_object_order order)
+{
+	auto &LevelSharedVertexState = LevelSharedSegmentState.get_vertex_state();
+	auto &Vertices = LevelSharedVertexState.get_vertices();
+	auto &vcvertptr = Vertices.vcptr;
+	auto &Objects = LevelUniqueObjectState.Objects;
+	const bool use_cache{
+#if DXX_USE_EDITOR
+		!EditorWindow
+#else
+		true
+#endif
+	};
+	if (use_cache && Segment_bounds.size() != Segments.get_count())
+	{
+		Segment_bounds.clear();
+		Segment_bounds.reserve(Segments.get_count());
+		for (auto &seg : Segments.vcptr)
+			Segment_bounds.push_back(build_segment_bounds(vcvertptr, seg));
+	}
+	const auto segment_overlaps_query{[&](const vcsegptridx_t segp) {
+		const auto bounds{use_cache ? Segment_bounds[segp] : build_segment_bounds(vcvertptr, segp)};
+		return static_cast<fix>(vm_vec_dist(center, bounds.center)) - bounds.radius <= static_cast<fix>(radius);
+	}};
+
+	const auto radius_squared{radius * radius};
+	result.clear();
+	visited_segment_bitarray_t visited;
+	/* Breadth-first search outward from start_seg.  A segment is only
+	 * entered if it overlaps the query sphere.  Any line from a point
+	 * in start_seg to a point in the sphere stays inside the sphere, so
+	 * every segment that object_to_object_visibility could pass through
+	 * is reached.
+	 */
+	std::array<segnum_t, MAX_SEGMENTS> queue;
+	auto queue_tail{queue.begin()};
+	*queue_tail++ = start_seg;
+	visited[start_seg] = true;
+	for (auto queue_head{queue.begin()}; queue_head != queue_tail; ++queue_head)
+	{
+		const auto &&segp{vcsegptridx(*queue_head)};
+		range_for (const auto objp, objects_in(segp, Objects.vcptridx, vcsegptr))
+		{
+			const auto dist2{vm_vec_dist2(center, objp->pos)};
+			if (dist2 <= radius_squared)
+				result.push_back({objp.get_unchecked_index(), dist2});
+		}
+		for (const auto child : segp->shared_segment::children)
+		{
+			if (!IS_CHILD(child))
+				continue;
+			auto &&v{visited[child]};
+			if (v)
+				continue;
+			v = true;
+			const auto &&childp{segp.absolute_sibling(child)};
+			if (segment_overlaps_query(childp))
+				*queue_tail++ = child;
+		}
+	}
+	if (order == nearby_object_order::objnum)
+		std::ranges::sort(result, {}, &nearby_object::objnum);
+	else
+		std::ranges::sort(result, [](const nearby_object &a, const nearby_object &b) {
+			return a.distance != b.distance ? a.distance < b.distance : a.objnum < b.objnum;
+		});
+}
+
+}
+
 namespace dcx {
 
 void (check_warn_object_type)(const object_base &o, object_type t, const char *file, unsigned line)
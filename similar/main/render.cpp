@@ -225,6 +225,45 @@ static constexpr int is_alphablend_eclip(const effect_index eclip_num)
 		eclip_num == effect_index::fuel_center;
 }
 
+// ----------------------------------------------------------------------------
+//	Compute the light of one vertex of a face.  l is the static light from the
+//	side's uvl, and is updated to include flashing and dynamic light.
+static g3s_lrgb build_face_vertex_light(fix &l, const g3s_lrgb &Dlvpi, const bool need_flashing_lights, const fix Seismic_tremor_magnitude)
+{
+	g3s_lrgb dli;
+	dli.r = dli.g = dli.b = l;
+	//the uvl struct has static light already in it
+
+	//scale static light for destruction effect
+	if (need_flashing_lights)	//make lights flash
+		l = fixmul(flash_scale, l);
+	//add in dynamic light (from explosions, etc.)
+	add_light_and_saturate(l, (Dlvpi.r + Dlvpi.g + Dlvpi.b) / 3);
+
+	// And now the same for the ACTUAL (rgb) light we want to use
+
+	//scale static light for destruction effect
+	if (need_flashing_lights)	//make lights flash
+	{
+		dli.g = dli.b = fixmul(flash_scale, l);
+		dli.r = (!Seismic_tremor_magnitude && PlayerCfg.DynLightColor)
+			? fixmul(std::max(static_cast<double>(flash_scale), f0_5 * 1.5), l) // let the mine glow red a little
+			: dli.g;
+	}
+
+	// add light color
+	add_light_and_saturate(dli.r, Dlvpi.r);
+	add_light_and_saturate(dli.g, Dlvpi.g);
+	add_light_and_saturate(dli.b, Dlvpi.b);
+	if (PlayerCfg.AlphaEffects) // due to additive blending, transparent sprites will become invivible in font of white surfaces (lamps). Fix that with a little desaturation
+	{
+		dli.r *= .93;
+		dli.g *= .93;
+		dli.b *= .93;
+	}
+	return dli;
+}
+
 // ----------------------------------------------------------------------------
 //	Render a face.
 //	It would be nice to not have to pass in segnum and sidenum, but
@@ -321,39 +360,7 @@ static void render_face(grs_canvas &canvas, const shared_segment &segp, const si
 	auto &Dynamic_light = LevelUniqueLightState.Dynamic_light;
 	//set light values for each vertex & build pointlist
 	for (auto &&[dli, uvli, vpi] : zip(std::span(dyn_light).first(nv), uvl_copy, vp))
-	{
-		auto &Dlvpi = Dynamic_light[vpi];
-		dli.r = dli.g = dli.b = uvli.l;
-		//the uvl struct has static light already in it
-
-		//scale static light for destruction effect
-		if (need_flashing_lights)	//make lights flash
-			uvli.l = fixmul(flash_scale, uvli.l);
-		//add in dynamic light (from explosions, etc.)
-		add_light_and_saturate(uvli.l, (Dlvpi.r + Dlvpi.g + Dlvpi.b) / 3);
-
-		// And now the same for the ACTUAL (rgb) light we want to use
-
-		//scale static light for destruction effect
-		if (need_flashing_lights)	//make lights flash
-		{
-			dli.g = dli.b = fixmul(flash_scale, uvli.l);
-			dli.r = (!Seismic_tremor_magnitude && PlayerCfg.DynLightColor)
-				? fixmul(std::max(static_cast<double>(flash_scale), f0_5 * 1.5), uvli.l) // let the mine glow red a little
-				: dli.g;
-		}
-
-		// add light color
-		add_light_and_saturate(dli.r, Dlvpi.r);
-		add_light_and_saturate(dli.g, Dlvpi.g);
-		add_light_and_saturate(dli.b, Dlvpi.b);
-		if (PlayerCfg.AlphaEffects) // due to additive blending, transparent sprites will become invivible in font of white surfaces (lamps). Fix that with a little desaturation
-		{
-			dli.r *= .93;
-			dli.g *= .93;
-			dli.b *= .93;
-		}
-	}
+		dli = build_face_vertex_light(uvli.l, Dynamic_light[vpi], need_flashing_lights, Seismic_tremor_magnitude);
 
 	bool alpha = false;
 	if (PlayerCfg.AlphaBlendEClips)
@@ -500,14 +507,18 @@ constexpr std::integral_constant<fix, (F1_0*15/16)> Min_n0_n1_dot{};
 //	Check for normal facing.  If so, render faces on side dictated by sidep->type.
 namespace dsx {
 namespace {
-static void render_side(fvcvertptr &vcvertptr, grs_canvas &canvas, const vcsegptridx_t segp, const sidenum_t sidenum, const wall_is_doorway_result wid_flags, const vms_vector &Viewer_eye)
+/* The faces of a side which face the viewer.  A side is drawn either as
+ * one quad, or as whichever of its two triangles face the viewer.
+ */
+struct side_render_faces
 {
-	fix		min_dot, max_dot;
-
-	if (!(wid_flags & WALL_IS_DOORWAY_FLAG::render))		//if (WALL_IS_DOORWAY(segp, sidenum) == wall_is_doorway_result::no_wall)
-		return;
+	bool quad;
+	bool face0, face1;
+};
 
-	const auto vertnum_list = get_side_verts(segp,sidenum);
+static side_render_faces get_side_render_faces(fvcvertptr &vcvertptr, const vcsegptridx_t segp, const sidenum_t sidenum, const std::array<vertnum_t, 4> &vertnum_list, const vms_vector &Viewer_eye)
+{
+	fix		min_dot, max_dot;
 
 	//	Regardless of whether this side is comprised of a single quad, or two triangles, we need to know one normal, so
 	//	deal with it, get the dot product.
@@ -521,67 +532,146 @@ static void render_side(fvcvertptr &vcvertptr, grs_canvas &canvas, const vcsegpt
 	const auto v_dot_n0 = vm_vec_build_dot(tvec, normals[0]);
 	//	========== Mark: Here is the change...beginning here: ==========
 
-	std::index_sequence<0, 1, 2, 3> is_quad;
-	const auto &uside = segp->unique_segment::sides[sidenum];
 	if (sside.type == side_type::quad)
-	{
-		if (v_dot_n0 >= 0) {
-			check_render_face(canvas, is_quad, segp, sidenum, 0, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
-		}
+		return {.quad = v_dot_n0 >= 0};
+	//	========== Mark: The change ends here. ==========
+
+	//	Although this side has been triangulated, because it is not planar, see if it is acceptable
+	//	to render it as a single quadrilateral.  This is a function of how far away the viewer is, how non-planar
+	//	the face is, how normal to the surfaces the view is.
+	//	Now, if both dot products are close to 1.0, then render two triangles as a single quad.
+	const auto v_dot_n1 = vm_vec_build_dot(tvec, normals[1]);
+
+	if (v_dot_n0 < v_dot_n1) {
+		min_dot = v_dot_n0;
+		max_dot = v_dot_n1;
 	} else {
-		//	========== Mark: The change ends here. ==========
-
-		//	Although this side has been triangulated, because it is not planar, see if it is acceptable
-		//	to render it as a single quadrilateral.  This is a function of how far away the viewer is, how non-planar
-		//	the face is, how normal to the surfaces the view is.
-		//	Now, if both dot products are close to 1.0, then render two triangles as a single quad.
-		const auto v_dot_n1 = vm_vec_build_dot(tvec, normals[1]);
+		min_dot = v_dot_n1;
+		max_dot = v_dot_n0;
+	}
 
-		if (v_dot_n0 < v_dot_n1) {
-			min_dot = v_dot_n0;
-			max_dot = v_dot_n1;
-		} else {
-			min_dot = v_dot_n1;
-			max_dot = v_dot_n0;
-		}
+	//	Determine whether to detriangulate side: (speed hack, assumes Tulate_min_ratio == F1_0*2, should fixmul(min_dot, Tulate_min_ratio))
+	if (DETRIANGULATION && (min_dot + F1_0 / 256 > max_dot || (Viewer->segnum != segp && min_dot > Tulate_min_dot && max_dot < min_dot * 2)) &&
+		//	The other detriangulation code doesn't deal well with badly non-planar sides.
+		vm_vec_build_dot(normals[0], normals[1]) >= Min_n0_n1_dot
+		)
+		return {.quad = true};
+	if (sside.type != side_type::tri_02 && sside.type != side_type::tri_13)
+		throw shared_side::illegal_type(segp, sside);
+	return {.quad = false, .face0 = v_dot_n0 >= 0, .face1 = v_dot_n1 >= 0};
+}
 
-		//	Determine whether to detriangulate side: (speed hack, assumes Tulate_min_ratio == F1_0*2, should fixmul(min_dot, Tulate_min_ratio))
-		if (DETRIANGULATION && (min_dot + F1_0 / 256 > max_dot || (Viewer->segnum != segp && min_dot > Tulate_min_dot && max_dot < min_dot * 2)) &&
-			//	The other detriangulation code doesn't deal well with badly non-planar sides.
-			vm_vec_build_dot(normals[0], normals[1]) >= Min_n0_n1_dot
-			)
-		{
-			check_render_face(canvas, is_quad, segp, sidenum, 0, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
-		} else {
-			if (sside.type == side_type::tri_02)
-			{
-				if (v_dot_n0 >= 0) {
-					check_render_face(canvas, std::index_sequence<0, 1, 2>(), segp, sidenum, 0, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
-				}
+static void render_side(fvcvertptr &vcvertptr, grs_canvas &canvas, const vcsegptridx_t segp, const sidenum_t sidenum, const wall_is_doorway_result wid_flags, const vms_vector &Viewer_eye)
+{
+	if (!(wid_flags & WALL_IS_DOORWAY_FLAG::render))		//if (WALL_IS_DOORWAY(segp, sidenum) == wall_is_doorway_result::no_wall)
+		return;
 
-				if (v_dot_n1 >= 0) {
-					// want to render from vertices 0, 2, 3 on side
-					check_render_face(canvas, std::index_sequence<0, 2, 3>(), segp, sidenum, 1, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
-				}
-			}
-			else if (sside.type == side_type::tri_13)
-			{
-				if (v_dot_n1 >= 0) {
-					// rendering 1,2,3, so just skip 0
-					check_render_face(canvas, std::index_sequence<1, 2, 3>(), segp, sidenum, 1, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
-				}
+	const auto vertnum_list = get_side_verts(segp,sidenum);
+	const auto faces{get_side_render_faces(vcvertptr, segp, sidenum, vertnum_list, Viewer_eye)};
+	const auto &uside = segp->unique_segment::sides[sidenum];
+	if (faces.quad)
+		check_render_face(canvas, std::index_sequence<0, 1, 2, 3>(), segp, sidenum, 0, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
+	else if (segp->shared_segment::sides[sidenum].type == side_type::tri_02)
+	{
+		if (faces.face0) {
+			check_render_face(canvas, std::index_sequence<0, 1, 2>(), segp, sidenum, 0, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
+		}
 
-				if (v_dot_n0 >= 0) {
-					// want to render from vertices 0,1,3
-					check_render_face(canvas, std::index_sequence<0, 1, 3>(), segp, sidenum, 0, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
-				}
+		if (faces.face1) {
+			// want to render from vertices 0, 2, 3 on side
+			check_render_face(canvas, std::index_sequence<0, 2, 3>(), segp, sidenum, 1, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
+		}
+	}
+	else
+	{
+		if (faces.face1) {
+			// rendering 1,2,3, so just skip 0
+			check_render_face(canvas, std::index_sequence<1, 2, 3>(), segp, sidenum, 1, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
+		}
 
-			} else
-				throw shared_side::illegal_type(segp, sside);
+		if (faces.face0) {
+			// want to render from vertices 0,1,3
+			check_render_face(canvas, std::index_sequence<0, 1, 3>(), segp, sidenum, 0, vertnum_list, uside.tmap_num, uside.tmap_num2, uside.uvls, wid_flags);
 		}
 	}
+}
+
+#if DXX_USE_OGL
+// -----------------------------------------------------------------------------------
+//	Queue a side for ogl_draw_level_geometry.  Returns false if the side must be
+//	drawn by render_side instead, because it needs blending, cloaking, a merged
+//	texture, or unlit texels that cannot share the side's vertex colors.
+static bool queue_level_side(fvcvertptr &vcvertptr, const vcsegptridx_t segp, const sidenum_t sidenum, const wall_is_doorway_result wid_flags, const vms_vector &Viewer_eye)
+{
+	if (!(wid_flags & WALL_IS_DOORWAY_FLAG::render))
+		return true;
+	if (wid_flags == wall_is_doorway_result::transparent_wall || wid_flags == wall_is_doorway_result::transillusory_wall
+#if DXX_BUILD_DESCENT == 2
+		|| (wid_flags & WALL_IS_DOORWAY_FLAG::cloaked)
+#endif
+		)
+		return false;
+#if DXX_USE_EDITOR
+	if (Render_only_bottom && sidenum == sidenum_t::WBOTTOM)
+		return false;
+#endif
+#ifndef NDEBUG
+	if (Outline_mode)
+		return false;
+#endif
+	auto &TmapInfo = LevelUniqueTmapInfoState.TmapInfo;
+	const auto &uside = segp->unique_segment::sides[sidenum];
+	const auto tmap2 = uside.tmap_num2;
+	const auto texture1_index{get_texture_index(uside.tmap_num)};
+	if (texture1_index >= TmapInfo.size()) [[unlikely]]
+		return false;
+	if (PlayerCfg.AlphaBlendEClips && is_alphablend_eclip(TmapInfo[texture1_index].eclip_num))
+		return false;
+	if (CGameArg.DbgUseOldTextureMerge && tmap2 != texture2_value::None)
+		return false;
+	const auto texture1{Textures[texture1_index]};
+	PIGGY_PAGE_IN(texture1);
+	auto &bm = GameBitmaps[texture1];
+	grs_bitmap *bm2 = nullptr;
+	if (tmap2 != texture2_value::None)
+	{
+		const auto texture2_index{get_texture_index(tmap2)};
+		if (texture2_index >= TmapInfo.size()) [[unlikely]]
+			return false;
+		const auto texture2{Textures[texture2_index]};
+		PIGGY_PAGE_IN(texture2);
+		bm2 = &GameBitmaps[texture2];
+		if (bm2->get_flag_mask(BM_FLAG_SUPER_TRANSPARENT | BM_FLAG_NO_LIGHTING))
+			return false;
+	}
+	if (bm.get_flag_mask(BM_FLAG_NO_LIGHTING))
+		return false;
 
+	//	Draw the same faces that render_side would, since face culling is not
+	//	enabled on every path that draws the level.
+	const auto vertnum_list = get_side_verts(segp, sidenum);
+	const auto faces{get_side_render_faces(vcvertptr, segp, sidenum, vertnum_list, Viewer_eye)};
+	if (!faces.quad && !faces.face0 && !faces.face1)
+		return true;
+
+	auto &LevelUniqueControlCenterState = LevelUniqueObjectState.ControlCenterState;
+#if DXX_BUILD_DESCENT == 1
+	const auto Seismic_tremor_magnitude{0};
+#elif DXX_BUILD_DESCENT == 2
+	const auto Seismic_tremor_magnitude = LevelUniqueSeismicState.Seismic_tremor_magnitude;
+#endif
+	const auto need_flashing_lights = (LevelUniqueControlCenterState.Control_center_destroyed | Seismic_tremor_magnitude);
+	auto &Dynamic_light = LevelUniqueLightState.Dynamic_light;
+	std::array<g3s_lrgb, 4> dyn_light;
+	for (auto &&[dli, uvli, vpi] : zip(dyn_light, uside.uvls, vertnum_list))
+	{
+		auto l = uvli.l;
+		dli = build_face_vertex_light(l, Dynamic_light[vpi], need_flashing_lights, Seismic_tremor_magnitude);
+	}
+	ogl_queue_level_side(segp, sidenum, {faces.quad, faces.face0, faces.face1}, uside.uvls, get_texture_rotation_low(tmap2), dyn_light, bm, bm2);
+	return true;
 }
+#endif
 
 #if DXX_USE_EDITOR
 static void render_object_search(grs_canvas &canvas, const d_level_unique_light_state &LevelUniqueLightState, const vmobjptridx_t obj)
@@ -762,12 +852,351 @@ static void project_list(const std::array<vertnum_t, 8> &pointnumlist)
 }
 }
 
+#if !DXX_USE_OGL
+namespace {
+
+/* Coarse depth buffer used by the software renderer to reject segments
+ * and objects that are hidden behind nearer opaque faces.
+ *
+ * The canvas is divided into 8x8 pixel tiles.  Each tile records the
+ * farthest depth of an opaque face that is known to cover the entire
+ * tile, or INT32_MAX if no such face has been found.  Tiles are grouped
+ * into 8x8 blocks, and each block caches the farthest depth of its
+ * tiles, so that large queries can usually be answered at block
+ * resolution.
+ *
+ * A box whose nearest point is farther than every tile it overlaps
+ * cannot contribute a visible pixel, regardless of the order in which
+ * the faces were recorded.
+ */
+class occlusion_buffer
+{
+	static constexpr unsigned tile_shift{3};
+	static constexpr unsigned block_shift{3};
+	static constexpr fix uncovered{INT32_MAX};
+	unsigned tiles_w{}, tiles_h{}, blocks_w{}, blocks_h{};
+	std::vector<fix> tiles, blocks;
+	void update_blocks(unsigned tx0, unsigned ty0, unsigned tx1, unsigned ty1);
+public:
+	void reset(unsigned canvas_w, unsigned canvas_h);
+	/* Record that the convex polygon `points`, clipped to `window`, will be
+	 * drawn opaquely and that no part of it is farther than `farthest_z`.
+	 */
+	void add_face(std::span<const g3s_point *const> points, const rect &window, fix farthest_z);
+	[[nodiscard]]
+	bool is_occluded(const rect &bounds, fix nearest_z) const;
+};
+
+void occlusion_buffer::reset(const unsigned canvas_w, const unsigned canvas_h)
+{
+	tiles_w = (canvas_w + (1u << tile_shift) - 1) >> tile_shift;
+	tiles_h = (canvas_h + (1u << tile_shift) - 1) >> tile_shift;
+	blocks_w = (tiles_w + (1u << block_shift) - 1) >> block_shift;
+	blocks_h = (tiles_h + (1u << block_shift) - 1) >> block_shift;
+	tiles.assign(tiles_w * tiles_h, uncovered);
+	blocks.assign(blocks_w * blocks_h, uncovered);
+}
+
+void occlusion_buffer::update_blocks(const unsigned tx0, const unsigned ty0, const unsigned tx1, const unsigned ty1)
+{
+	for (const auto by : xrange(ty0 >> block_shift, (ty1 >> block_shift) + 1))
+		for (const auto bx : xrange(tx0 >> block_shift, (tx1 >> block_shift) + 1))
+		{
+			fix farthest{};
+			const auto y_end{std::min((by + 1) << block_shift, tiles_h)};
+			const auto x_end{std::min((bx + 1) << block_shift, tiles_w)};
+			for (const auto ty : xrange(by << block_shift, y_end))
+				for (const auto tx : xrange(bx << block_shift, x_end))
+					farthest = std::max(farthest, tiles[ty * tiles_w + tx]);
+			blocks[by * blocks_w + bx] = farthest;
+		}
+}
+
+void occlusion_buffer::add_face(const std::span<const g3s_point *const> points, const rect &window, const fix farthest_z)
+{
+	/* Determine the winding of the polygon, and reject it if it is not
+	 * strictly convex.  The coverage test below is only valid for convex
+	 * polygons.
+	 */
+	const auto n{points.size()};
+	const auto edge_cross = [points, n](const std::size_t i, const fix x, const fix y) {
+		const auto &a{*points[i]};
+		const auto &b{*points[(i + 1) % n]};
+		return (int64_t{b.p3_sx} - a.p3_sx) * (int64_t{y} - a.p3_sy) - (int64_t{b.p3_sy} - a.p3_sy) * (int64_t{x} - a.p3_sx);
+	};
+	int winding{};
+	fix min_x{INT32_MAX}, min_y{INT32_MAX}, max_x{INT32_MIN}, max_y{INT32_MIN};
+	for (const auto i : xrange(n))
+	{
+		const auto &c{*points[(i + 2) % n]};
+		const auto cross{edge_cross(i, c.p3_sx, c.p3_sy)};
+		if (!cross)
+			return;
+		const int w{cross > 0 ? 1 : -1};
+		if (winding && w != winding)
+			return;
+		winding = w;
+		min_x = std::min(min_x, points[i]->p3_sx);
+		max_x = std::max(max_x, points[i]->p3_sx);
+		min_y = std::min(min_y, points[i]->p3_sy);
+		max_y = std::max(max_y, points[i]->p3_sy);
+	}
+	const auto inside = [&edge_cross, n, winding](const fix x, const fix y) {
+		for (const auto i : xrange(n))
+			if ((edge_cross(i, x, y) > 0 ? 1 : -1) != winding)
+				return false;
+		return true;
+	};
+	/* Only consider tiles which lie entirely inside both the window and
+	 * the bounding box of the polygon.
+	 */
+	constexpr int tile_size{1 << tile_shift};
+	const int left{std::max<int>(window.left, f2i(min_x) + 1)};
+	const int top{std::max<int>(window.top, f2i(min_y) + 1)};
+	const int right{std::min<int>(window.right, f2i(max_x) - 1)};
+	const int bot{std::min<int>(window.bot, f2i(max_y) - 1)};
+	if (left < 0 || top < 0)
+		return;
+	const unsigned tx0{static_cast<unsigned>(left + tile_size - 1) >> tile_shift};
+	const unsigned ty0{static_cast<unsigned>(top + tile_size - 1) >> tile_shift};
+	if (right + 1 < tile_size || bot + 1 < tile_size)
+		return;
+	const unsigned tx1{std::min((static_cast<unsigned>(right + 1) >> tile_shift), tiles_w) - 1};
+	const unsigned ty1{std::min((static_cast<unsigned>(bot + 1) >> tile_shift), tiles_h) - 1};
+	if (tx0 > tx1 || ty0 > ty1)
+		return;
+	bool changed{false};
+	for (const auto ty : xrange(ty0, ty1 + 1))
+	{
+		/* Test the tile corners with a one pixel margin, so that rounding
+		 * in the rasterizer cannot leave a gap along the polygon edges.
+		 */
+		const fix y0{i2f(static_cast<int>(ty << tile_shift) - 1)};
+		const fix y1{i2f(static_cast<int>((ty + 1) << tile_shift) + 1)};
+		for (const auto tx : xrange(tx0, tx1 + 1))
+		{
+			auto &t{tiles[ty * tiles_w + tx]};
+			if (t <= farthest_z)
+				continue;
+			const fix x0{i2f(static_cast<int>(tx << tile_shift) - 1)};
+			const fix x1{i2f(static_cast<int>((tx + 1) << tile_shift) + 1)};
+			if (inside(x0, y0) && inside(x1, y0) && inside(x0, y1) && inside(x1, y1))
+			{
+				t = farthest_z;
+				changed = true;
+			}
+		}
+	}
+	if (changed)
+		update_blocks(tx0, ty0, tx1, ty1);
+}
+
+bool occlusion_buffer::is_occluded(const rect &bounds, const fix nearest_z) const
+{
+	if (bounds.right < bounds.left || bounds.bot < bounds.top)
+		return false;
+	const unsigned tx0{static_cast<unsigned>(std::max<int>(bounds.left, 0)) >> tile_shift};
+	const unsigned ty0{static_cast<unsigned>(std::max<int>(bounds.top, 0)) >> tile_shift};
+	const unsigned tx1{std::min(static_cast<unsigned>(std::max<int>(bounds.right, 0)) >> tile_shift, tiles_w - 1)};
+	const unsigned ty1{std::min(static_cast<unsigned>(std::max<int>(bounds.bot, 0)) >> tile_shift, tiles_h - 1)};
+	for (const auto by : xrange(ty0 >> block_shift, (ty1 >> block_shift) + 1))
+		for (const auto bx : xrange(tx0 >> block_shift, (tx1 >> block_shift) + 1))
+		{
+			if (blocks[by * blocks_w + bx] < nearest_z)
+				continue;
+			/* Some tile in this block is not known to be nearer than the
+			 * box.  Check the tiles which the box overlaps.
+			 */
+			const auto y_end{std::min(((by + 1) << block_shift) - 1, ty1)};
+			const auto x_end{std::min(((bx + 1) << block_shift) - 1, tx1)};
+			for (const auto ty : xrange(std::max(by << block_shift, ty0), y_end + 1))
+				for (const auto tx : xrange(std::max(bx << block_shift, tx0), x_end + 1))
+					if (tiles[ty * tiles_w + tx] >= nearest_z)
+						return false;
+		}
+	return true;
+}
+
+/* Compute the screen-space bounding rectangle and the nearest depth of
+ * the convex hull of `points`.  Return std::nullopt if any point is
+ * behind the viewer or could not be projected, since such a hull
+ * cannot be safely rejected.
+ */
+template <typename R>
+std::optional<std::pair<rect, fix>> compute_screen_extent(R &&points)
+{
+	fix min_x{INT32_MAX}, min_y{INT32_MAX}, max_x{INT32_MIN}, max_y{INT32_MIN}, nearest_z{INT32_MAX};
+	for (g3s_point &p : points)
+	{
+		if ((p.p3_codes & clipping_code::behind) != clipping_code::None)
+			return std::nullopt;
+		g3_project_point(p);
+		if (!(p.p3_flags & projection_flag::projected) || +(p.p3_flags & projection_flag::overflow))
+			return std::nullopt;
+		min_x = std::min(min_x, p.p3_sx);
+		max_x = std::max(max_x, p.p3_sx);
+		min_y = std::min(min_y, p.p3_sy);
+		max_y = std::max(max_y, p.p3_sy);
+		nearest_z = std::min(nearest_z, p.p3_vec.z);
+	}
+	if (nearest_z <= 0)
+		return std::nullopt;
+	const auto clamp_short = [](const int v) {
+		return static_cast<short>(std::clamp<int>(v, INT16_MIN, INT16_MAX));
+	};
+	return std::pair(rect{
+		.left = clamp_short(f2i(min_x) - 1),
+		.top = clamp_short(f2i(min_y) - 1),
+		.right = clamp_short(f2i(max_x) + 1),
+		.bot = clamp_short(f2i(max_y) + 1),
+	}, nearest_z);
+}
+
+occlusion_buffer Occlusion_buffer;
+
+}
+#endif
+
 
 // -----------------------------------------------------------------------------------
 #if !DXX_USE_OGL
 namespace dsx {
 namespace {
-static void render_segment(fvcvertptr &vcvertptr, fvcwallptr &vcwallptr, const vms_vector &Viewer_eye, grs_canvas &canvas, const vcsegptridx_t seg)
+/* Return true if every pixel of this side that render_side draws is
+ * drawn opaquely, so that the side may be recorded in the occlusion
+ * buffer.
+ */
+static bool side_is_occluder(const unique_side &uside, const wall_is_doorway_result wid_flags)
+{
+	if (wid_flags != wall_is_doorway_result::wall && wid_flags != wall_is_doorway_result::illusory_wall)
+		return false;
+	auto &TmapInfo = LevelUniqueTmapInfoState.TmapInfo;
+	const auto texture1_index{get_texture_index(uside.tmap_num)};
+	if (texture1_index >= TmapInfo.size())
+		return false;
+	if (GameBitmaps[Textures[texture1_index]].get_flag_mask(BM_FLAG_TRANSPARENT | BM_FLAG_SUPER_TRANSPARENT))
+		return false;
+	if (PlayerCfg.AlphaBlendEClips && is_alphablend_eclip(TmapInfo[texture1_index].eclip_num))
+		return false;
+	if (const auto tmap2{uside.tmap_num2}; tmap2 != texture2_value::None)
+	{
+		const auto texture2_index{get_texture_index(tmap2)};
+		if (texture2_index >= TmapInfo.size())
+			return false;
+		if (GameBitmaps[Textures[texture2_index]].get_flag_mask(BM_FLAG_SUPER_TRANSPARENT))
+			return false;
+	}
+	return true;
+}
+
+/* Walk the render list from nearest to farthest.  Mark each segment
+ * which is hidden by the opaque sides already recorded, and record the
+ * opaque sides of each segment which will be drawn.
+ */
+static void build_occlusion_buffer(fvcvertptr &vcvertptr, fvcwallptr &vcwallptr, const vms_vector &Viewer_eye, render_state_t &rstate)
+{
+	for (const auto segnum : partial_const_range(rstate.Render_list, rstate.N_render_segs))
+	{
+		if (segnum == segment_none)
+			continue;
+		auto &srsm = rstate.render_seg_map[segnum];
+		const auto &&seg = vcsegptridx(segnum);
+		if (rotate_list(vcvertptr, seg->verts).uand != clipping_code::None)
+			continue;
+		const auto &rw = srsm.render_window;
+		if (const auto extent{compute_screen_extent(seg->verts | std::views::transform([](const vertnum_t v) -> g3s_point & { return Segment_points[v]; }))})
+		{
+			const auto &[bounds, nearest_z] = *extent;
+			if (Occlusion_buffer.is_occluded(rect{
+					.left = std::max(bounds.left, rw.left),
+					.top = std::max(bounds.top, rw.top),
+					.right = std::min(bounds.right, rw.right),
+					.bot = std::min(bounds.bot, rw.bot),
+				}, nearest_z))
+			{
+				srsm.occluded = true;
+				continue;
+			}
+		}
+		for (const auto sn : MAX_SIDES_PER_SEGMENT)
+		{
+			const auto &uside = seg->unique_segment::sides[sn];
+			if (!side_is_occluder(uside, WALL_IS_DOORWAY(GameBitmaps, Textures, vcwallptr, seg, sn)))
+				continue;
+			const auto vertnum_list = get_side_verts(seg, sn);
+			/* Only record sides which render_side draws completely.  For a
+			 * triangulated side, that requires both triangles to face the
+			 * viewer.
+			 */
+			const auto &sside = seg->shared_segment::sides[sn];
+			const auto tvec = vm_vec_normalized_quick(vm_vec_build_sub(Viewer_eye, vcvertptr(vertnum_list[sside.type == side_type::tri_13 ? 1 : 0])));
+			if (vm_vec_build_dot(tvec, sside.normals[0]) < 0)
+				continue;
+			if (sside.type != side_type::quad && vm_vec_build_dot(tvec, sside.normals[1]) < 0)
+				continue;
+			std::array<const g3s_point *, 4> pointlist;
+			fix farthest_z{};
+			bool usable{true};
+			for (auto &&[p, v] : zip(pointlist, vertnum_list))
+			{
+				auto &pnt = Segment_points[v];
+				if ((pnt.p3_codes & clipping_code::behind) != clipping_code::None)
+				{
+					usable = false;
+					break;
+				}
+				g3_project_point(pnt);
+				if (!(pnt.p3_flags & projection_flag::projected) || +(pnt.p3_flags & projection_flag::overflow))
+				{
+					usable = false;
+					break;
+				}
+				farthest_z = std::max(farthest_z, pnt.p3_vec.z);
+				p = &pnt;
+			}
+			if (usable)
+				Occlusion_buffer.add_face(pointlist, rw, farthest_z);
+		}
+	}
+}
+
+/* Return true if `obj` is known to be hidden by the occlusion buffer.
+ * Only object types whose drawing is bounded by their size are tested.
+ */
+static bool object_is_occluded(const object_base &obj)
+{
+	switch (obj.render_type)
+	{
+		case render_type::RT_POLYOBJ:
+		case render_type::RT_FIREBALL:
+		case render_type::RT_HOSTAGE:
+		case render_type::RT_POWERUP:
+		case render_type::RT_WEAPON_VCLIP:
+			break;
+		default:
+			return false;
+	}
+	if (obj.attached_obj != object_none)
+		return false;
+	/* Project the corners of the world-aligned cube which encloses the
+	 * bounding sphere of the object.
+	 */
+	const auto size{obj.size};
+	std::array<g3s_point, 8> corners;
+	for (auto &&[i, c] : enumerate(corners))
+	{
+		const vms_vector v{
+			.x = obj.pos.x + ((i & 1) ? size : -size),
+			.y = obj.pos.y + ((i & 2) ? size : -size),
+			.z = obj.pos.z + ((i & 4) ? size : -size),
+		};
+		g3_rotate_point(c, v);
+	}
+	const auto extent{compute_screen_extent(corners)};
+	return extent && Occlusion_buffer.is_occluded(extent->first, extent->second);
+}
+
+static void render_segment(fvcvertptr &vcvertptr, fvcwallptr &vcwallptr, const vms_vector &Viewer_eye, grs_canvas &canvas, const vcsegptridx_t seg, const bool occluded)
 {
 	if (rotate_list(vcvertptr, seg->verts).uand == clipping_code::None)
 	{		//all off screen?
@@ -779,8 +1208,9 @@ static void render_segment(fvcvertptr &vcvertptr, fvcwallptr &vcwallptr, const v
 			LevelUniqueAutomapState.Automap_visited[seg] = 1;
 		}
 
-		for (const auto sn : MAX_SIDES_PER_SEGMENT)
-			render_side(vcvertptr, canvas, seg, sn, WALL_IS_DOORWAY(GameBitmaps, Textures, vcwallptr, seg, sn), Viewer_eye);
+		if (!occluded)
+			for (const auto sn : MAX_SIDES_PER_SEGMENT)
+				render_side(vcvertptr, canvas, seg, sn, WALL_IS_DOORWAY(GameBitmaps, Textures, vcwallptr, seg, sn), Viewer_eye);
 	}
 
 	//draw any objects that happen to be in this segment
@@ -1608,6 +2038,9 @@ void render_mine(grs_canvas &canvas, const vms_vector &Viewer_eye, const vcsegid
 		}
 	}
 #if !DXX_USE_OGL
+	Occlusion_buffer.reset(canvas.cv_bitmap.bm_w, canvas.cv_bitmap.bm_h);
+	if (!_search_mode)
+		build_occlusion_buffer(vcvertptr, vcwallptr, Viewer_eye, rstate);
 	range_for (const auto segnum, reversed_render_range)
 	{
 		// Interpolation_method = 0;
@@ -1626,7 +2059,7 @@ void render_mine(grs_canvas &canvas, const vms_vector &Viewer_eye, const vcsegid
 				Window_clip_bot   = rw.bot;
 			}
 
-			render_segment(vcvertptr, vcwallptr, Viewer_eye, *grd_curcanv, vcsegptridx(segnum));
+			render_segment(vcvertptr, vcwallptr, Viewer_eye, *grd_curcanv, vcsegptridx(segnum), srsm.occluded);
 			visited[segnum]=3;
 			if (srsm.objects.empty())
 				continue;
@@ -1642,7 +2075,10 @@ void render_mine(grs_canvas &canvas, const vms_vector &Viewer_eye, const vcsegid
 				const auto save_linear_depth = std::exchange(Max_linear_depth, Max_linear_depth_objects);
 				range_for (auto &v, srsm.objects)
 				{
-					do_render_object(canvas, LevelUniqueLightState, vmobjptridx(v.objnum), window);	// note link to above else
+					const auto &&objp = vmobjptridx(v.objnum);
+					if (!_search_mode && object_is_occluded(objp))
+						continue;
+					do_render_object(canvas, LevelUniqueLightState, objp, window);	// note link to above else
 				}
 				Max_linear_depth = save_linear_depth;
 			}
@@ -1657,6 +2093,48 @@ void render_mine(grs_canvas &canvas, const vms_vector &Viewer_eye, const vcsegid
 	auto &vcvertptr = Vertices.vcptr;
 	auto &Walls = LevelUniqueWallSubsystemState.Walls;
 	auto &vcwallptr = Walls.vcptr;
+	const auto render_opaque_pass_side = [&](const vcsegptridx_t seg, const sidenum_t sn, const wall_is_doorway_result wid) {
+		if (wid == wall_is_doorway_result::transparent_wall || wid == wall_is_doorway_result::transillusory_wall
+#if DXX_BUILD_DESCENT == 2
+			|| (wid & WALL_IS_DOORWAY_FLAG::cloaked)
+#endif
+			)
+		{
+			if (PlayerCfg.AlphaBlendEClips)
+			{
+				const auto texture1_index{get_texture_index(seg->unique_segment::sides[sn].tmap_num)};
+				if (texture1_index >= TmapInfo.size()) [[unlikely]]
+				{
+					/* Do nothing - skip indexing into TmapInfo */
+				}
+				else if (is_alphablend_eclip(TmapInfo[texture1_index].eclip_num))
+					// Do NOT render geometry with blending textures. Since we've not rendered any objects, yet, they would disappear behind them.
+					return;
+			}
+			glAlphaFunc(GL_GEQUAL,0.8); // prevent ugly outlines if an object (which is rendered later) is shown behind a grate, door, etc. if texture filtering is enabled. These sides are rendered later again with normal AlphaFunc
+			render_side(vcvertptr, canvas, seg, sn, wid, Viewer_eye);
+			glAlphaFunc(GL_GEQUAL,0.02);
+		}
+		else
+			render_side(vcvertptr, canvas, seg, sn, wid, Viewer_eye);
+	};
+	// With -gl_levelvbo, sides that can be drawn from the level buffers are
+	// queued, and the rest are drawn after them so that blended sides are
+	// composited over the queued geometry behind them.
+#if DXX_USE_EDITOR
+	if (EditorWindow)
+		ogl_invalidate_level_geometry();
+	const bool queue_level_sides = !EditorWindow && !_search_mode && ogl_begin_level_geometry();
+#else
+	const bool queue_level_sides = ogl_begin_level_geometry();
+#endif
+	struct deferred_side
+	{
+		segnum_t segnum;
+		sidenum_t sidenum;
+		wall_is_doorway_result wid;
+	};
+	std::vector<deferred_side> deferred_sides;
         // First Pass: render opaque level geometry and level geometry with alpha pixels (high Alpha-Test func)
 	range_for (const auto segnum, reversed_render_range)
 	{
@@ -1686,34 +2164,21 @@ void render_mine(grs_canvas &canvas, const vms_vector &Viewer_eye, const vcsegid
 					for (const auto sn : MAX_SIDES_PER_SEGMENT)
 					{
 						const auto wid = WALL_IS_DOORWAY(GameBitmaps, Textures, vcwallptr, seg, sn);
-						if (wid == wall_is_doorway_result::transparent_wall || wid == wall_is_doorway_result::transillusory_wall
-#if DXX_BUILD_DESCENT == 2
-							|| (wid & WALL_IS_DOORWAY_FLAG::cloaked)
-#endif
-							)
-						{
-							if (PlayerCfg.AlphaBlendEClips)
-							{
-								const auto texture1_index{get_texture_index(seg->unique_segment::sides[sn].tmap_num)};
-								if (texture1_index >= TmapInfo.size()) [[unlikely]]
-								{
-									/* Do nothing - skip indexing into TmapInfo */
-								}
-								else if (is_alphablend_eclip(TmapInfo[texture1_index].eclip_num))
-									// Do NOT render geometry with blending textures. Since we've not rendered any objects, yet, they would disappear behind them.
-									continue;
-							}
-							glAlphaFunc(GL_GEQUAL,0.8); // prevent ugly outlines if an object (which is rendered later) is shown behind a grate, door, etc. if texture filtering is enabled. These sides are rendered later again with normal AlphaFunc
-							render_side(vcvertptr, canvas, seg, sn, wid, Viewer_eye);
-							glAlphaFunc(GL_GEQUAL,0.02);
-						}
-						else
-							render_side(vcvertptr, canvas, seg, sn, wid, Viewer_eye);
+						if (!queue_level_sides)
+							render_opaque_pass_side(seg, sn, wid);
+						else if (!queue_level_side(vcvertptr, seg, sn, wid, Viewer_eye))
+							deferred_sides.push_back({seg, sn, wid});
 					}
 				}
 			}
 		}
 	}
+	if (queue_level_sides)
+	{
+		ogl_draw_level_geometry();
+		for (const auto &d : deferred_sides)
+			render_opaque_pass_side(vcsegptridx(d.segnum), d.sidenum, d.wid);
+	}
 
         // Second pass: Render objects and level geometry with alpha pixels (normal Alpha-Test func) and eclips with blending
 	range_for (const auto segnum, reversed_render_range)
@@ -120,6 +120,26 @@ static int Redbook_playing = 0; // Redbook track num differs from Song_playing.
 user_configured_level_songs BIMSongs;
 user_configured_level_songs BIMSecretSongs;
 
+/* Return the builtin song for `level_songnum`, or song_number::None if
+ * the song list has no level songs.
+ */
+static song_number get_builtin_level_song(const level_song_number level_songnum)
+{
+	/* Level songs start at offset `song_number::first_level_song`, so
+	 * require that the song list contain more than that many entries.
+	 * A list with at most `song_number::first_level_song` entries only
+	 * has non-level songs, so nothing can be played for level songs.
+	 */
+	const auto size{BIMSongs.size()};
+	if (size <= static_cast<std::size_t>(song_number::first_level_song))
+		return song_number::None;
+	/* Compute `count_level_songs` to exclude songs assigned to
+	 * non-levels, such as title, briefing, etc.
+	 */
+	const auto count_level_songs{size - static_cast<std::size_t>(song_number::first_level_song)};
+	return build_song_number_from_level_song_number(static_cast<level_song_number>(underlying_value(level_songnum) % count_level_songs));
+}
+
 }
 
 song_number songs_is_playing()
@@ -463,6 +483,7 @@ void songs_uninit()
 	songs_stop_all();
 #if DXX_USE_SDLMIXER
 	jukebox_unload();
+	mix_clear_music_cache();
 #endif
 	BIMSecretSongs.reset();
 	BIMSongs.reset();
@@ -799,18 +820,8 @@ void songs_play_level_song(int levelnum, int offset)
 				}
 				break;
 			}
-			/* Level songs start at offset `song_number::first_level_song`, so
-			 * require that the song list contain more than that many entries.
-			 * A list with at most `song_number::first_level_song` entries only
-			 * has non-level songs, so nothing can be played for level songs.
-			 */
-			if (const auto size{BIMSongs.size()}; size > static_cast<std::size_t>(song_number::first_level_song))
+			if (const auto songnum{get_builtin_level_song(level_songnum)}; songnum != song_number::None)
 			{
-				/* Compute `count_level_songs` to exclude songs assigned to
-				 * non-levels, such as title, briefing, etc.
-				 */
-				const auto count_level_songs{size - static_cast<std::size_t>(song_number::first_level_song)};
-				const song_number songnum{build_song_number_from_level_song_number(static_cast<level_song_number>(underlying_value(level_songnum) % count_level_songs))};
 				if (songs_play_file(BIMSongs[songnum].filename.data(), 1, nullptr))
 					Song_playing = songnum;
 			}
@@ -929,4 +940,21 @@ void songs_play_level_song(int levelnum, int offset)
 	return;
 }
 
+// start converting the song for levelnum ahead of songs_play_level_song, so that starting the level does not wait for it
+void songs_prefetch_level_song(const int levelnum)
+{
+#if DXX_USE_SDLMIXER && !defined(_WIN32)
+	/* Only builtin songs need converting.  Secret levels are not
+	 * prefetched, since the next secret level is not known in advance.
+	 */
+	if (CGameCfg.MusicType != music_type::Builtin || levelnum <= 0)
+		return;
+	songs_init();
+	if (const auto songnum{get_builtin_level_song(static_cast<level_song_number>(levelnum - 1))}; songnum != song_number::None)
+		mix_prefetch_file(BIMSongs[songnum].filename.data());
+#else
+	(void)levelnum;
+#endif
+}
+
 }
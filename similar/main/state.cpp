@@ -145,6 +145,13 @@ enum class savegame_mission_name_abi : uint8_t
 {
 	original,
 	pathname,
+	/* As `pathname`, but the save holds more than LEGACY_MAX_OBJECTS
+	 * objects.  Older releases reject an unknown value here before they
+	 * read any objects, so they never overrun their smaller object array.
+	 * They do not check STATE_VERSION against an upper bound, so raising
+	 * it would not stop them.
+	 */
+	pathname_extended_objects,
 };
 
 static_assert(sizeof(savegame_mission_path) == sizeof(savegame_mission_path::original) + sizeof(savegame_mission_path::full), "padding error");
@@ -1391,7 +1398,11 @@ int state_save_all_sub(const char *filename, const char *desc)
 #if DXX_BUILD_DESCENT == 2
 	mission_pathname.original[1] = static_cast<uint8_t>(Current_mission->descent_version);
 #endif
-	mission_pathname.original.back() = static_cast<uint8_t>(savegame_mission_name_abi::pathname);
+	mission_pathname.original.back() = static_cast<uint8_t>(
+		Highest_object_index < LEGACY_MAX_OBJECTS
+		? savegame_mission_name_abi::pathname
+		: savegame_mission_name_abi::pathname_extended_objects
+	);
 	auto Current_mission_pathname = Current_mission->path.c_str();
 	// Current_mission_filename is not necessarily 9 bytes long so for saving we use a proper string - preventing corruptions
 	snprintf(mission_pathname.full.data(), mission_pathname.full.size(), "%s", Current_mission_pathname);
@@ -1913,7 +1924,8 @@ int state_restore_all_sub(const d_level_shared_destructible_light_state &LevelSh
 	PHYSFSX_readBytes(fp, mission_pathname.original.data(), mission_pathname.original.size());
 	mission_name_type name_match_mode;
 	mission_entry_predicate mission_predicate;
-	switch (static_cast<savegame_mission_name_abi>(mission_pathname.original.back()))
+	std::size_t saved_object_capacity{LEGACY_MAX_OBJECTS};
+	switch (const auto mission_name_abi{static_cast<savegame_mission_name_abi>(mission_pathname.original.back())})
 	{
 		case savegame_mission_name_abi::original:	/* Save game without the ability to do extended mission names */
 			name_match_mode = mission_name_type::basename;
@@ -1923,6 +1935,9 @@ int state_restore_all_sub(const d_level_shared_destructible_light_state &LevelSh
 #endif
 			break;
 		case savegame_mission_name_abi::pathname:	/* Save game with extended mission name */
+		case savegame_mission_name_abi::pathname_extended_objects:
+			if (mission_name_abi == savegame_mission_name_abi::pathname_extended_objects)
+				saved_object_capacity = MAX_OBJECTS;
 			{
 				PHYSFSX_readBytes(fp, mission_pathname.full.data(), mission_pathname.full.size());
 				if (mission_pathname.full.back())
@@ -2096,16 +2111,20 @@ int state_restore_all_sub(const d_level_shared_destructible_light_state &LevelSh
 
 	Do_appearance_effect = 0;			// Don't do this for middle o' game stuff.
 
+	//Read objects, and pop 'em into their respective segments.
+	const auto saved_object_count{PHYSFSX_readSXE32(fp, swap)};
+	if (saved_object_count < 1 || static_cast<std::size_t>(saved_object_count) > saved_object_capacity)
+	{
+		nm_messagebox(menu_title{TXT_ERROR}, {TXT_OK}, "Unable to load game\nSave game has %i objects", saved_object_count);
+		return 0;
+	}
+
 	//Clear out all the objects from the lvl file
 	for (unique_segment &useg : vmsegptr)
 		useg.objects = object_none;
 	reset_objects(LevelUniqueObjectState, 1);
 
-	//Read objects, and pop 'em into their respective segments.
-	{
-		const auto i{PHYSFSX_readSXE32(fp, swap)};
-	Objects.set_count(i);
-	}
+	Objects.set_count(saved_object_count);
 	for (auto &obj : vmobjptr)
 	{
 		object_rw obj_rw;
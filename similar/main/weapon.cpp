@@ -1555,8 +1555,7 @@ imobjptridx_t spit_powerup(d_level_unique_object_state &LevelUniqueObjectState,
 
 void DropCurrentWeapon (player_info &player_info)
 {
-	auto &Objects{LevelUniqueObjectState.Objects};
-	if (LevelUniqueObjectState.num_objects >= Objects.size())
+	if (LevelUniqueObjectState.num_objects >= LevelUniqueObjectState.object_limit)
 		return;
 
 	powerup_type_t drop_type;
@@ -1658,11 +1657,10 @@ void DropCurrentWeapon (player_info &player_info)
 
 void DropSecondaryWeapon (player_info &player_info)
 {
-	auto &Objects = LevelUniqueObjectState.Objects;
 	int seed;
 	ushort sub_ammo{0};
 
-	if (LevelUniqueObjectState.num_objects >= Objects.size())
+	if (LevelUniqueObjectState.num_objects >= LevelUniqueObjectState.object_limit)
 		return;
 
 	auto &Secondary_weapon = player_info.Secondary_weapon;
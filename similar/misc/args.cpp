@@ -151,6 +151,7 @@ static void arg_port_number(Arglist::iterator &pp, Arglist::const_iterator end,
 static void InitGameArg()
 {
 	CGameArg.SysMaxFPS = MAXIMUM_FPS;
+	CGameArg.SysObjectHeadroom = DEFAULT_OBJECT_HEADROOM;
 	CGameArg.SysRenderZoomAdjustment = 0;
 #if DXX_USE_UDP
 	CGameArg.MplUdpHostAddr = UDP_MANUAL_ADDR_DEFAULT;
@@ -214,6 +215,8 @@ static void ReadCmdArgs(Inilist &ini, Arglist &&Args)
 			CGameArg.SysNoNiceFPS = true;
 		else if (!d_stricmp(p, "-maxfps"))
 			CGameArg.SysMaxFPS = arg_integer(pp, end);
+		else if (!d_stricmp(p, "-fixed-tickrate"))
+			CGameArg.SysFixedTickRate = arg_integer(pp, end);
 		else if (!d_stricmp(p, "-render-zoom"))
 			CGameArg.SysRenderZoomAdjustment = arg_integer(pp, end);
 		else if (!d_stricmp(p, "-hogdir"))
@@ -235,12 +238,20 @@ static void ReadCmdArgs(Inilist &ini, Arglist &&Args)
 			CGameArg.SysUsePlayersDir = static_cast<int8_t>(- (sizeof(PLAYER_DIRECTORY_TEXT) - 1));
 		else if (!d_stricmp(p, "-lowmem"))
 			CGameArg.SysLowMem = true;
+		else if (!d_stricmp(p, "-object-headroom"))
+			CGameArg.SysObjectHeadroom = arg_integer(pp, end);
+		else if (!d_stricmp(p, "-worker-threads"))
+			CGameArg.SysWorkerThreads = arg_integer(pp, end);
 		else if (!d_stricmp(p, "-pilot"))
 			CGameArg.SysPilot = arg_string(pp, end);
 		else if (!d_stricmp(p, "-record-demo-format"))
 			CGameArg.SysRecordDemoNameTemplate = arg_string(pp, end);
 		else if (!d_stricmp(p, "-auto-record-demo"))
 			CGameArg.SysAutoRecordDemo = true;
+		else if (!d_stricmp(p, "-demoanalyze"))
+			CGameArg.SysAnalyzeDemos.emplace_back(arg_string(pp, end));
+		else if (!d_stricmp(p, "-demo-capture"))
+			CGameArg.SysDemoCaptureRate = arg_integer(pp, end);
 		else if (!d_stricmp(p, "-window"))
 			CGameArg.SysWindow = true;
 		else if (!d_stricmp(p, "-noborders"))
@@ -326,6 +337,10 @@ static void ReadCmdArgs(Inilist &ini, Arglist &&Args)
 			CGameArg.OglSyncWait = arg_integer(pp, end);
 		else if (!d_stricmp(p, "-gl_darkedges"))
 			CGameArg.OglDarkEdges = true;
+		else if (!d_stricmp(p, "-gl_levelvbo"))
+			CGameArg.OglLevelVBO = true;
+		else if (!d_stricmp(p, "-gl_hudatlas"))
+			CGameArg.OglHudAtlas = true;
 #if DXX_USE_STEREOSCOPIC_RENDER
 		else if (!d_stricmp(p, "-gl_stereo"))
 			CGameArg.OglStereo = true;
@@ -467,6 +482,13 @@ static void PostProcessGameArg()
 		CGameArg.SysMaxFPS = MINIMUM_FPS;
 	else if (CGameArg.SysMaxFPS > MAXIMUM_FPS)
 		CGameArg.SysMaxFPS = MAXIMUM_FPS;
+	/* 0 disables fixed rate stepping, so only clamp nonzero values. */
+	if (CGameArg.SysFixedTickRate && CGameArg.SysFixedTickRate < DESIGNATED_GAME_FPS)
+		CGameArg.SysFixedTickRate = DESIGNATED_GAME_FPS;
+	else if (CGameArg.SysFixedTickRate > MAXIMUM_FPS)
+		CGameArg.SysFixedTickRate = MAXIMUM_FPS;
+	if (CGameArg.SysDemoCaptureRate > MAXIMUM_FPS)
+		CGameArg.SysDemoCaptureRate = MAXIMUM_FPS;
 #if PHYSFS_VER_MAJOR >= 2
 	if (!CGameArg.SysMissionDir.empty())
 		PHYSFS_mount(CGameArg.SysMissionDir.c_str(), MISSION_DIR, 1);